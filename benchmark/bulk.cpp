@@ -0,0 +1,103 @@
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixbulk.hpp"
+#include "simulator.hpp"
+
+using namespace simulator;
+
+/**
+ * Reconciliation style pass over a log, parses every message and sums the
+ * traded notional per chunk.
+ */
+struct NotionalVisitor
+{
+    uint64_t messages = 0;
+    double notional = 0.0;
+    MarketDataIncrementalRefresh md;
+    ExecutionReport report;
+    void operator()(MessageTypeEnum msgType, const char* buffer, size_t n)
+    {
+        messages++;
+        if (msgType == MessageTypeEnum::MarketDataIncrementalRefresh) {
+            md.parse(buffer);
+            for (int64_t i = 0; i < md.get<NoMDEntries>(); ++i)
+                notional += md.get<MDEntries, MDEntryPx>(i) * md.get<MDEntries, MDEntrySize>(i);
+        }
+        else if (msgType == MessageTypeEnum::ExecutionReport) {
+            report.parse(buffer);
+            notional += report.get<Price>() * report.get<OrderQty>();
+        }
+    }
+};
+
+static const std::string& bulkLog()
+{
+    static std::string log = [](){
+        std::string out;
+        char buffer[2048];
+        MarketDataIncrementalRefresh md;
+        md.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+        md.set<SenderCompId>("EXCHANGE");
+        md.set<TargetCompId>("DROPCOPY");
+        md.set<MDReqID>("BULK");
+        md.set<NoMDEntries>(4);
+        md.resize<MDEntries>(4);
+        ExecutionReport report;
+        report.set<MessageType>(MessageTypeEnum::ExecutionReport);
+        report.set<SenderCompId>("EXCHANGE");
+        report.set<TargetCompId>("DROPCOPY");
+        report.set<ExecType>('F');
+        report.set<OrderStatus>('2');
+        report.set<Symbol>("BTC-PERPETUAL");
+        report.set<Side>('1');
+        for (int i = 0; i < 200000; ++i) {
+            int bytes = 0;
+            if (i % 2) {
+                md.set<MsgSeqNum>(i);
+                md.set<SendingTime>();
+                for (int j = 0; j < 4; ++j) {
+                    md.set<MDEntries, MDUpdateAction>(j, '1');
+                    md.set<MDEntries, MDEntryType>(j, j % 2 ? '1' : '0');
+                    md.set<MDEntries, Symbol>(j, "BTC-PERPETUAL");
+                    md.set<MDEntries, MDEntryPx>(j, 100.0 + (i + j) % 64, 2);
+                    md.set<MDEntries, MDEntrySize>(j, 1.0 + j, 1);
+                }
+                bytes = md.dump(buffer, true, true);
+            }
+            else {
+                report.set<MsgSeqNum>(i);
+                report.set<SendingTime>();
+                report.set<OrderID>(details::itoa(i));
+                report.set<ClOrdID>(details::itoa(i));
+                report.set<ExecID>(details::itoa(i));
+                report.set<OrderQty>(1.0 + i % 8, 1);
+                report.set<Price>(100.0 + i % 64, 2);
+                bytes = report.dump(buffer, true, true);
+            }
+            out.append(buffer, bytes);
+        }
+        return out;
+    }();
+    return log;
+}
+
+static void BM_ParseParallel(benchmark::State &state)
+{
+    const std::string& log = bulkLog();
+    size_t threads = state.range(0);
+    uint64_t messages = 0;
+    for (auto _ : state)
+    {
+        auto total = parse_parallel<NotionalVisitor>(log.data(), log.size(), threads, [](){ return NotionalVisitor(); },
+                [](NotionalVisitor& into, NotionalVisitor&& next) {
+                    into.messages += next.messages;
+                    into.notional += next.notional;
+                });
+        benchmark::DoNotOptimize(total.notional);
+        messages += total.messages;
+    }
+    state.SetItemsProcessed(long(messages));
+    state.SetBytesProcessed(long(state.iterations()) * long(log.size()));
+}
+BENCHMARK(BM_ParseParallel)->UseRealTime()->Unit(benchmark::kMillisecond)->Arg(1)->Arg(2)->Arg(4);
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <numeric>
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixate.hpp"
+
+using namespace fixate;
+
+namespace {
+
+    using PxRows = TvpVector<TvpGroup<BidPx, BidSize, OfferPx, OfferSize>>;
+    using PxColumns = TvpColumnar<TvpGroup<BidPx, BidSize, OfferPx, OfferSize>>;
+
+    template <typename PxGroup>
+    using QuoteRefresh = FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime,
+        MDReqID, NoMDEntries, PxGroup
+    >;
+
+    template <typename PxGroup>
+    int makeQuotes(char* buffer, int levels) {
+        QuoteRefresh<PxGroup> msg;
+        msg.template set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+        msg.template set<MsgSeqNum>(1);
+        msg.template set<SenderCompId>("FEED");
+        msg.template set<TargetCompId>("BOOK");
+        msg.template set<SendingTime>();
+        msg.template set<MDReqID>("COLUMNS");
+        msg.template set<NoMDEntries>(levels);
+        msg.template resize<PxGroup>(levels);
+        for (int i = 0; i < levels; ++i) {
+            msg.template set<PxGroup, BidPx>(i, 20000.0 - 0.5 * ((i * 7) % levels), 2);
+            msg.template set<PxGroup, BidSize>(i, 1.0 + i, 1);
+            msg.template set<PxGroup, OfferPx>(i, 20001.0 + 0.5 * ((i * 7) % levels), 2);
+            msg.template set<PxGroup, OfferSize>(i, 1.0 + i, 1);
+        }
+        return msg.dump(buffer, true, true);
+    }
+}
+
+/**
+ * Parse a quote group of `range(0)` levels, then `range(1)` times take the
+ * best bid and offer and the bid and offered size. Rows decode the text on
+ * every access.
+ */
+static void BM_GroupScanRows(benchmark::State &state)
+{
+    const int levels = state.range(0);
+    const int passes = state.range(1);
+    char buffer[16384];
+    makeQuotes<PxRows>(buffer, levels);
+    QuoteRefresh<PxRows> msg;
+    for (auto _ : state)
+    {
+        msg.parse(buffer);
+        for (int p = 0; p < passes; ++p) {
+            double bid = 0.0, offer = 1e300, size = 0.0;
+            for (int i = 0; i < levels; ++i) {
+                bid = std::max(bid, msg.get<PxRows, BidPx>(i));
+                offer = std::min(offer, msg.get<PxRows, OfferPx>(i));
+                size += msg.get<PxRows, BidSize>(i) + msg.get<PxRows, OfferSize>(i);
+            }
+            benchmark::DoNotOptimize(bid + offer + size);
+        }
+    }
+    state.SetItemsProcessed(long(state.iterations()) * levels);
+}
+BENCHMARK(BM_GroupScanRows)->ArgsProduct({{8, 64, 256}, {1, 4}});
+
+//! As above, over the columns decoded while parsing.
+static void BM_GroupScanColumns(benchmark::State &state)
+{
+    const int levels = state.range(0);
+    const int passes = state.range(1);
+    char buffer[16384];
+    makeQuotes<PxColumns>(buffer, levels);
+    QuoteRefresh<PxColumns> msg;
+    for (auto _ : state)
+    {
+        msg.parse(buffer);
+        const PxColumns& group = msg.field<PxColumns>();
+        for (int p = 0; p < passes; ++p) {
+            double bid = *std::max_element(group.column<BidPx>(), group.column<BidPx>() + levels);
+            double offer = *std::min_element(group.column<OfferPx>(), group.column<OfferPx>() + levels);
+            double size = std::accumulate(group.column<BidSize>(), group.column<BidSize>() + levels, 0.0)
+                + std::accumulate(group.column<OfferSize>(), group.column<OfferSize>() + levels, 0.0);
+            benchmark::DoNotOptimize(bid + offer + size);
+        }
+    }
+    state.SetItemsProcessed(long(state.iterations()) * levels);
+}
+BENCHMARK(BM_GroupScanColumns)->ArgsProduct({{8, 64, 256}, {1, 4}});
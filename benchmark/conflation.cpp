@@ -0,0 +1,111 @@
+#include <random>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixbulk.hpp"
+#include "fixate/fixconflate.hpp"
+#include "simulator.hpp"
+
+using namespace simulator;
+
+namespace {
+
+    //! Incremental feed over `instruments` books, two updates per message.
+    std::string makeFeed(int messages, int instruments)
+    {
+        std::mt19937_64 rng(7);
+        std::uniform_int_distribution<int> instrument(0, instruments - 1), level(1, 16), action(0, 9);
+        std::uniform_real_distribution<double> size(0.1, 50.0);
+        MarketDataIncrementalRefresh md;
+        md.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+        md.set<SenderCompId>("FEED");
+        md.set<TargetCompId>("STRATEGY");
+        md.set<SendingTime>();
+        md.set<MDReqID>("CONFLATE");
+        md.set<NoMDEntries>(2);
+        md.resize<MDEntries>(2);
+        std::string feed;
+        char buffer[4096];
+        for (int m = 0; m < messages; ++m) {
+            std::string symbol = "INSTRUMENT-" + std::to_string(instrument(rng));
+            md.set<MsgSeqNum>(m + 1);
+            for (int i = 0; i < 2; ++i) {
+                int a = action(rng);
+                md.set<MDEntries, MDUpdateAction>(i, a < 2 ? '0' : a < 9 ? '1' : '2');
+                md.set<MDEntries, MDEntryType>(i, i == 0 ? '0' : '1');
+                md.set<MDEntries, Symbol>(i, symbol);
+                md.set<MDEntries, MDEntryPx>(i, i == 0 ? 100.0 - level(rng) : 100.0 + level(rng), 1);
+                md.set<MDEntries, MDEntrySize>(i, size(rng), 1);
+            }
+            feed.append(buffer, md.dump(buffer, true, true));
+        }
+        return feed;
+    }
+
+    //! Strategy which keeps a book per instrument and is slow on every message.
+    struct SlowStrategy
+    {
+        instrument_registry* registry;
+        std::vector<OrderBook> books;
+        MarketDataIncrementalRefresh md;
+        int work;
+        SlowStrategy(instrument_registry* registry, int work)
+            : registry(registry), books(registry->capacity()), work(work) {}
+        void operator()(MessageTypeEnum msgType, const char* buffer, size_t n)
+        {
+            if (msgType != MessageTypeEnum::MarketDataIncrementalRefresh) return;
+            md.parse(buffer);
+            for (int64_t i = 0; i < md.get<NoMDEntries>(); ++i) {
+                OrderBook& book = books[registry->intern(md.get<MDEntries, Symbol>(i))];
+                book.update(md.get<MDEntries, MDEntryType>(i), md.get<MDEntries, MDUpdateAction>(i),
+                        md.get<MDEntries, MDEntryPx>(i), md.get<MDEntries, MDEntrySize>(i));
+            }
+            for (int i = 0; i < work; ++i) benchmark::DoNotOptimize(i);
+        }
+    };
+
+    using Conflater = ConflatingVisitor<SlowStrategy, MarketDataIncrementalRefresh, MDEntries>;
+}
+
+/**
+ * A backlog of 100k refreshes over 16 instruments drained by a strategy
+ * which spends `range(0)` spins per message, handed every message in order.
+ */
+static void BM_SlowConsumerDirect(benchmark::State &state)
+{
+    const std::string feed = makeFeed(100000, 16);
+    for (auto _ : state)
+    {
+        instrument_registry registry(64);
+        SlowStrategy strategy(&registry, state.range(0));
+        mapped_chunk source(feed.data(), feed.data() + feed.size());
+        FixEngine<mapped_chunk, SlowStrategy> engine(&source, &strategy);
+        engine.connect();
+        while (source.active()) engine.perform();
+    }
+    state.SetItemsProcessed(long(state.iterations()) * 100000);
+}
+BENCHMARK(BM_SlowConsumerDirect)->Arg(200)->Unit(benchmark::kMillisecond);
+
+//! As above through a ConflatingVisitor holding up to 1024 updates.
+static void BM_SlowConsumerConflated(benchmark::State &state)
+{
+    const std::string feed = makeFeed(100000, 16);
+    conflation_stats stats;
+    for (auto _ : state)
+    {
+        instrument_registry registry(64);
+        SlowStrategy strategy(&registry, state.range(0));
+        Conflater conflater(&strategy, &registry, 1024);
+        mapped_chunk source(feed.data(), feed.data() + feed.size());
+        FixEngine<mapped_chunk, Conflater> engine(&source, &conflater);
+        engine.connect();
+        while (source.active()) engine.perform();
+        conflater.flush();
+        stats = conflater.stats();
+    }
+    state.SetItemsProcessed(long(state.iterations()) * 100000);
+    state.counters["delivered"] = double(stats.messages_out) / stats.messages_in;
+    state.counters["merged"] = double(stats.merged()) / stats.updates_in;
+}
+BENCHMARK(BM_SlowConsumerConflated)->Arg(200)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixate.hpp"
+
+using namespace fixate;
+
+//! SendingTime at millisecond precision through gmtime and strfutc, one stamp per microsecond.
+static void BM_StrfutcGmtime(benchmark::State &state)
+{
+    char buffer[32];
+    int64_t ts = 1735689600000000000LL;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(strfutc<clock_precision::milliseconds>(buffer, ts));
+        benchmark::ClobberMemory();
+        ts += 1000;
+    }
+}
+BENCHMARK(BM_StrfutcGmtime);
+
+//! The same through the thread's cached formatter.
+static void BM_StrfutcCached(benchmark::State &state)
+{
+    char buffer[32];
+    int64_t ts = 1735689600000000000LL;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(strfutc_cached<clock_precision::milliseconds>(buffer, ts));
+        benchmark::ClobberMemory();
+        ts += 1000;
+    }
+}
+BENCHMARK(BM_StrfutcCached);
+
+//! A timestamp from CLOCK_REALTIME through the vDSO.
+static void BM_ClockRealtime(benchmark::State &state)
+{
+    for (auto _ : state) benchmark::DoNotOptimize(realtime_timestamp());
+}
+BENCHMARK(BM_ClockRealtime);
+
+//! A timestamp from the calibrated TSC.
+static void BM_ClockTsc(benchmark::State &state)
+{
+    if (!tsc_clock::supported()) { state.SkipWithError("no invariant TSC"); return; }
+    tsc_clock& clock = tsc_clock::instance();
+    for (auto _ : state) benchmark::DoNotOptimize(clock.now());
+}
+BENCHMARK(BM_ClockTsc);
+
+namespace {
+
+    //! The parser strtutc replaced, std::tm and timegm.
+    int64_t strtutcTimegm(const char* src, int size)
+    {
+        auto two = [src](int i) { return (src[i] - '0') * 10 + src[i + 1] - '0'; };
+        std::tm dt = {};
+        dt.tm_year = two(0) * 100 + two(2) - 1900;
+        dt.tm_mon = two(4) - 1;
+        dt.tm_mday = two(6);
+        dt.tm_hour = two(9);
+        dt.tm_min = two(12);
+        dt.tm_sec = two(15);
+        int64_t frac = 0;
+        for (int i = 18; i < size; ++i) frac = frac * 10 + src[i] - '0';
+        return int64_t(timegm(&dt)) * 1000000000LL + frac * (size > 24 ? 1 : size > 21 ? 1000 : 1000000);
+    }
+    const char* const SENDING_TIMES[] = {"20250101-09:30:00.123", "20250615-17:45:59.999", "20251231-23:59:59.000"};
+}
+
+//! SendingTime with milliseconds through std::tm and timegm.
+static void BM_StrtutcTimegm(benchmark::State &state)
+{
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(strtutcTimegm(SENDING_TIMES[i], 21));
+        if (++i == 3) i = 0;
+    }
+}
+BENCHMARK(BM_StrtutcTimegm);
+
+//! The same through strtutc.
+static void BM_StrtutcArithmetic(benchmark::State &state)
+{
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(strtutc(SENDING_TIMES[i], 21));
+        if (++i == 3) i = 0;
+    }
+}
+BENCHMARK(BM_StrtutcArithmetic);
+
+//! Cancel and reschedule a timeout among `range(0)` pending timers, as for every TestRequest.
+static void BM_TimerWheelRearm(benchmark::State &state)
+{
+    timer_wheel wheel;
+    int64_t now = system_timestamp();
+    for (int64_t i = 0; i < state.range(0); ++i) wheel.schedule_at(now + (i + 1) * 1000000000LL, [](int64_t) {});
+    timer_wheel::id_type id = wheel.schedule_at(now + 15000000000LL, [](int64_t) {});
+    for (auto _ : state)
+    {
+        wheel.cancel(id);
+        id = wheel.schedule_at(now + 15000000000LL, [](int64_t) {});
+        benchmark::DoNotOptimize(wheel.next_deadline());
+    }
+}
+BENCHMARK(BM_TimerWheelRearm)->Arg(16)->Arg(4096);
@@ -0,0 +1,47 @@
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixate.hpp"
+
+using namespace fixate;
+
+namespace {
+
+    std::vector<std::string> makeSymbols(size_t n) {
+        std::vector<std::string> symbols;
+        for (size_t i = 0; i < n; ++i) symbols.push_back("BTC-" + std::to_string(20250101 + i) + "-C");
+        return symbols;
+    }
+}
+
+//! Symbol to instrument id through the registry, `range(0)` instruments.
+static void BM_InstrumentRegistryFind(benchmark::State &state)
+{
+    auto symbols = makeSymbols(state.range(0));
+    instrument_registry registry(symbols.size());
+    for (const auto& s : symbols) registry.intern(s);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(registry.find(symbols[i]));
+        if (++i == symbols.size()) i = 0;
+    }
+}
+BENCHMARK(BM_InstrumentRegistryFind)->Arg(16)->Arg(4096);
+
+//! The same through a std::unordered_map keyed by string_view.
+static void BM_InstrumentHashMapFind(benchmark::State &state)
+{
+    auto symbols = makeSymbols(state.range(0));
+    std::unordered_map<std::string_view, uint32_t> map;
+    for (const auto& s : symbols) map.emplace(s, uint32_t(map.size()));
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.find(symbols[i])->second);
+        if (++i == symbols.size()) i = 0;
+    }
+}
+BENCHMARK(BM_InstrumentHashMapFind)->Arg(16)->Arg(4096);
@@ -0,0 +1,235 @@
+#include <new>
+#include <cstring>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "simulator.hpp"
+
+using namespace simulator;
+
+static void fill(Logon& msg) {
+    msg.set<MessageType>(MessageTypeEnum::Logon);
+    msg.set<EncryptMethod>('0');
+    msg.set<HeartBtInt>(30);
+}
+
+static void fill(NewOrderSingle& msg) {
+    msg.set<MessageType>(MessageTypeEnum::NewOrderSingle);
+    msg.set<ClOrdID>("ORDER-0000000001");
+    msg.set<Symbol>("BTC-PERPETUAL");
+    msg.set<Side>('1');
+    msg.set<OrderQty>(10.0, 2);
+    msg.set<OrderType>('2');
+    msg.set<Price>(100.25, 2);
+}
+
+//! NewOrderSingle with its MsgType rendered at compile time.
+typedef FixMessage<
+    FixVersionType::FIX_4_4,
+    TvpConstant<&TagMessageType, &M_NewOrderSingle>, MsgSeqNum, SenderCompId, TargetCompId, SendingTime,
+    ClOrdID, Symbol, Side, OrderQty, OrderType, Price
+> ConstantNewOrderSingle;
+
+static void fill(ConstantNewOrderSingle& msg) {
+    msg.set<ClOrdID>("ORDER-0000000001");
+    msg.set<Symbol>("BTC-PERPETUAL");
+    msg.set<Side>('1');
+    msg.set<OrderQty>(10.0, 2);
+    msg.set<OrderType>('2');
+    msg.set<Price>(100.25, 2);
+}
+
+static void fill(ExecutionReport& msg) {
+    msg.set<MessageType>(MessageTypeEnum::ExecutionReport);
+    msg.set<OrderID>("1000001");
+    msg.set<ClOrdID>("ORDER-0000000001");
+    msg.set<ExecID>("2000001");
+    msg.set<ExecType>('0');
+    msg.set<OrderStatus>('0');
+    msg.set<Symbol>("BTC-PERPETUAL");
+    msg.set<Side>('1');
+    msg.set<OrderQty>(10.0, 2);
+    msg.set<Price>(100.25, 2);
+    msg.set<LeavesQty>(10.0, 2);
+    msg.set<CumQty>(0.0, 1);
+    msg.set<AvgPx>(0.0, 1);
+}
+
+static void fill(MarketDataIncrementalRefresh& msg) {
+    msg.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+    msg.set<MDReqID>("LAYOUT");
+    msg.set<NoMDEntries>(4);
+    msg.resize<MDEntries>(4);
+    for (int i = 0; i < 4; ++i) {
+        msg.set<MDEntries, MDUpdateAction>(i, '1');
+        msg.set<MDEntries, MDEntryType>(i, i % 2 ? '1' : '0');
+        msg.set<MDEntries, Symbol>(i, "BTC-PERPETUAL");
+        msg.set<MDEntries, MDEntryPx>(i, 100.0 + i, 2);
+        msg.set<MDEntries, MDEntrySize>(i, 1.0 + i, 1);
+    }
+}
+
+/**
+ * Parse throughput of a message type next to its footprint: `sizeof`, the
+ * cache lines the object spans and the lines a parse actually writes to.
+ * Group entries live on the heap and are not part of the object.
+ */
+template <typename TMessage>
+static void BM_MessageLayout(benchmark::State &state)
+{
+    char buffer[1024];
+    {
+        TMessage sample;
+        fill(sample);
+        sample.template set<MsgSeqNum>(1);
+        sample.template set<SenderCompId>("SENDER");
+        sample.template set<TargetCompId>("TARGET");
+        sample.template set<SendingTime>();
+        sample.dump(buffer, true, true);
+    }
+
+    // Fill the storage with a pattern so that every byte written by parse shows.
+    alignas(TMessage) unsigned char storage[sizeof(TMessage)];
+    std::memset(storage, 0xa5, sizeof(storage));
+    TMessage* msg = new (storage) TMessage();
+    unsigned char before[sizeof(TMessage)];
+    std::memcpy(before, storage, sizeof(storage));
+    msg->parse(buffer);
+    int touched = 0;
+    for (size_t line = 0; line < sizeof(storage); line += 64) {
+        size_t n = std::min<size_t>(64, sizeof(storage) - line);
+        touched += std::memcmp(before + line, storage + line, n) != 0;
+    }
+
+    for (auto _ : state)
+    {
+        msg->parse(buffer);
+        benchmark::DoNotOptimize(msg);
+        benchmark::ClobberMemory();
+    }
+    msg->~TMessage();
+    state.counters["sizeof"] = sizeof(TMessage);
+    state.counters["cache_lines"] = (sizeof(TMessage) + 63) / 64;
+    state.counters["lines_touched"] = touched;
+}
+BENCHMARK_TEMPLATE(BM_MessageLayout, Logon);
+BENCHMARK_TEMPLATE(BM_MessageLayout, NewOrderSingle);
+BENCHMARK_TEMPLATE(BM_MessageLayout, ConstantNewOrderSingle);
+BENCHMARK_TEMPLATE(BM_MessageLayout, ExecutionReport);
+BENCHMARK_TEMPLATE(BM_MessageLayout, MarketDataIncrementalRefresh);
+
+//! Serialisation of the same messages, BodyLength and CheckSum included, in three walks: width, sum and dump.
+template <typename TMessage>
+static void BM_MessageDump(benchmark::State &state)
+{
+    char buffer[1024];
+    TMessage msg;
+    fill(msg);
+    msg.template set<MsgSeqNum>(1);
+    msg.template set<SenderCompId>("SENDER");
+    msg.template set<TargetCompId>("TARGET");
+    msg.template set<SendingTime>();
+    int bytes = 0;
+    for (auto _ : state)
+    {
+        bytes = msg.dump(buffer, true, true);
+        benchmark::DoNotOptimize(buffer);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * bytes);
+}
+BENCHMARK_TEMPLATE(BM_MessageDump, Logon);
+BENCHMARK_TEMPLATE(BM_MessageDump, NewOrderSingle);
+BENCHMARK_TEMPLATE(BM_MessageDump, ConstantNewOrderSingle);
+BENCHMARK_TEMPLATE(BM_MessageDump, ExecutionReport);
+BENCHMARK_TEMPLATE(BM_MessageDump, MarketDataIncrementalRefresh);
+
+//! The same messages through the single pass `encode`, which is what `FixEngine::sendmsg` uses.
+template <typename TMessage>
+static void BM_MessageEncode(benchmark::State &state)
+{
+    char buffer[1024];
+    TMessage msg;
+    fill(msg);
+    msg.template set<MsgSeqNum>(1);
+    msg.template set<SenderCompId>("SENDER");
+    msg.template set<TargetCompId>("TARGET");
+    msg.template set<SendingTime>();
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        bytes = msg.encode(buffer).size();
+        benchmark::DoNotOptimize(buffer);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * bytes);
+}
+BENCHMARK_TEMPLATE(BM_MessageEncode, Logon);
+BENCHMARK_TEMPLATE(BM_MessageEncode, NewOrderSingle);
+BENCHMARK_TEMPLATE(BM_MessageEncode, ConstantNewOrderSingle);
+BENCHMARK_TEMPLATE(BM_MessageEncode, ExecutionReport);
+BENCHMARK_TEMPLATE(BM_MessageEncode, MarketDataIncrementalRefresh);
+
+/**
+ * Data source writing to one end of a UNIX socket pair and draining the
+ * other, so that the kernel copies the message as it would for TCP.
+ */
+struct SocketPairSink
+{
+    int fds[2] = {-1, -1};
+    char drain[16384];
+    SocketPairSink() { (void)!::socketpair(AF_UNIX, SOCK_STREAM, 0, fds); }
+    ~SocketPairSink() { ::close(fds[0]); ::close(fds[1]); }
+    int send_message(const char* buffer, int size) { return settle(::write(fds[0], buffer, size)); }
+    int send_iov(iovec* iov, int count) { return settle(::writev(fds[0], iov, count)); }
+    int settle(int bytes) {
+        for (int n = 0; n < bytes; ) n += ::read(fds[1], drain, sizeof(drain));
+        return bytes;
+    }
+};
+
+typedef FixMessage<
+    FixVersionType::FIX_4_4,
+    MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime, RawDataLength, RawData
+> RawDataMessage;
+
+/**
+ * A message carrying `state.range(0)` bytes of RawData, rendered whole
+ * into a buffer and written, against gathered with the RawData referenced
+ * where it is stored (an `iov_writer` of threshold 1) and written with
+ * `writev`. The measurement behind `iov_writer::REFERENCE_SIZE`, both
+ * render into a buffer of their own to run past the engine's request
+ * buffer.
+ */
+template <bool Gather>
+static void BM_SendRawData(benchmark::State &state)
+{
+    SocketPairSink sink;
+    RawDataMessage msg;
+    msg.set<MessageType>(MessageTypeEnum::Logon);
+    msg.set<MsgSeqNum>(1);
+    msg.set<SenderCompId>("SENDER");
+    msg.set<TargetCompId>("TARGET");
+    msg.set<SendingTime>();
+    msg.set<RawDataLength>(int(state.range(0)));
+    msg.set<RawData>(std::string(state.range(0), 'x'));
+    std::vector<char> buffer(state.range(0) + 512);
+    char scratch[512];
+    iovec iov[8];
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        if (Gather) {
+            iov_writer w(iov, 8, scratch, sizeof(scratch), 1);
+            msg.dump_iov(w);
+            bytes = sink.send_iov(w.iov(), w.size());
+        } else {
+            std::string_view out = msg.encode(buffer.data());
+            bytes = sink.send_message(out.data(), out.size());
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * bytes);
+}
+BENCHMARK_TEMPLATE(BM_SendRawData, false)->RangeMultiplier(2)->Range(256, 64 << 10);
+BENCHMARK_TEMPLATE(BM_SendRawData, true)->RangeMultiplier(2)->Range(256, 64 << 10);
@@ -0,0 +1,143 @@
+#include <atomic>
+#include <thread>
+#include <benchmark/benchmark.h>
+
+#include "simulator.hpp"
+
+using namespace simulator;
+
+/**
+ * Initiator side of the loopback session, it logs on to the simulator and
+ * counts the acknowledgements and market data updates it receives.
+ */
+class LoopbackClient
+{
+public:
+    typedef FixEngine<tcp_client, LoopbackClient> FixEngineType;
+public:
+    LoopbackClient(const SimulatorConf& conf)
+        : mDataSource(conf.localAddress, conf.port, [](){}, [](){},
+                [](int, const std::string&){}),
+          mFixEngine(&mDataSource, this) { mDataSource.set_timestamping(timestamping::software); }
+    bool connectAndLogOn() {
+        if (!mFixEngine.connect()) return false;
+        Logon logon;
+        logon.set<MessageType>(MessageTypeEnum::Logon);
+        logon.set<EncryptMethod>('0');
+        logon.set<HeartBtInt>(30);
+        sendmsg(logon);
+        while (!mIsLoggedOn && mDataSource.active()) { mFixEngine.perform(); }
+        return mIsLoggedOn;
+    }
+    void disconnect() { mFixEngine.disconnect(); }
+    bool perform() { return mFixEngine.perform(); }
+    void sendOrder(int64_t id) {
+        mOrder.set<MessageType>(MessageTypeEnum::NewOrderSingle);
+        mOrder.set<ClOrdID>(details::itoa(id));
+        mOrder.set<Symbol>("BTC-PERPETUAL");
+        mOrder.set<Side>('1');
+        mOrder.set<OrderQty>(1.0, 1);
+        mOrder.set<OrderType>('2');
+        mOrder.set<Price>(100.5, 2);
+        sendmsg(mOrder);
+    }
+    uint64_t acks() const { return mAcks; }
+    uint64_t updates() const { return mUpdates; }
+
+    void operator()(MessageTypeEnum msgType, const char* buffer, size_t n, const message_context& ctx)
+    {
+        if (msgType == MessageTypeEnum::Logon) { mIsLoggedOn = true; }
+        else if (msgType == MessageTypeEnum::ExecutionReport) { mAcks++; }
+        else if (msgType == MessageTypeEnum::MarketDataIncrementalRefresh) {
+            mUpdates++;
+            mBytes += n;
+            if (ctx.timestamp.software > 0) {
+                mWireToApp += epoch_timestamp() - ctx.timestamp.software;
+                mStamped++;
+            }
+        }
+    }
+    uint64_t bytes() const { return mBytes; }
+    //! Mean delay between the kernel receiving a market data update and the visitor seeing it.
+    double wireToAppNs() const { return mStamped ? double(mWireToApp) / mStamped : 0.0; }
+private:
+    template <typename TFixMessage>
+    size_t sendmsg(TFixMessage& msg) {
+        msg.template set<MsgSeqNum>(++mOutMsgSeqNum);
+        msg.template set<SenderCompId>("CLIENT");
+        msg.template set<TargetCompId>("SIMULATOR");
+        msg.template set<SendingTime>();
+        return mFixEngine.sendmsg(msg);
+    }
+private:
+    tcp_client mDataSource;
+    FixEngineType mFixEngine;
+    NewOrderSingle mOrder;
+    bool mIsLoggedOn = false;
+    int mOutMsgSeqNum = 0;
+    uint64_t mAcks = 0;
+    uint64_t mUpdates = 0;
+    uint64_t mBytes = 0;
+    int64_t mWireToApp = 0;
+    uint64_t mStamped = 0;
+};
+
+static void BM_OrderAckRoundTrip(benchmark::State &state)
+{
+    SimulatorConf conf;
+    ExchangeSimulator sim(conf);
+    sim.listen();
+    std::atomic<bool> running{true};
+    std::thread exchange([&](){ if (sim.accept()) sim.run(running); });
+
+    LoopbackClient client(conf);
+    if (!client.connectAndLogOn()) {
+        running = false;
+        exchange.join();
+        state.SkipWithError("Failed to log on to the simulator");
+        return;
+    }
+    int64_t id = 0;
+    for (auto _ : state)
+    {
+        client.sendOrder(++id);
+        while (client.acks() < uint64_t(id)) { client.perform(); }
+    }
+    client.disconnect();
+    running = false;
+    exchange.join();
+    state.SetItemsProcessed(long(state.iterations()));
+}
+BENCHMARK(BM_OrderAckRoundTrip)->UseRealTime();
+
+static void BM_MarketDataFeed(benchmark::State &state)
+{
+    SimulatorConf conf;
+    conf.marketDataIntervalNs = state.range(0);
+    conf.marketDataEntries = state.range(1);
+    ExchangeSimulator sim(conf);
+    sim.listen();
+    std::atomic<bool> running{true};
+    std::thread exchange([&](){ if (sim.accept()) sim.run(running); });
+
+    LoopbackClient client(conf);
+    if (!client.connectAndLogOn()) {
+        running = false;
+        exchange.join();
+        state.SkipWithError("Failed to log on to the simulator");
+        return;
+    }
+    uint64_t received = client.updates();
+    for (auto _ : state)
+    {
+        while (client.updates() == received) { client.perform(); }
+        received = client.updates();
+    }
+    client.disconnect();
+    running = false;
+    exchange.join();
+    state.SetItemsProcessed(long(state.iterations()));
+    state.SetBytesProcessed(long(client.bytes()));
+    state.counters["wire_to_app_ns"] = client.wireToAppNs();
+}
+BENCHMARK(BM_MarketDataFeed)->UseRealTime()->ArgsProduct({{1000, 10000, 100000}, {4, 16}});
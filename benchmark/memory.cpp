@@ -0,0 +1,35 @@
+#include <random>
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixmemory.hpp"
+
+using namespace fixate;
+
+/**
+ * Random reads across a 64 MB region, bound by dTLB reach with 4 KB pages.
+ * Arg is the requested `page_size`, the label shows what backs the region.
+ */
+static void BM_RegionRandomRead(benchmark::State &state)
+{
+    const size_t size = size_t(64) << 20;
+    memory_policy policy;
+    policy.pages = page_size(state.range(0));
+    policy.prefault = true;
+    memory_region region(size, policy);
+    const char* labels[] = {"normal", "transparent", "huge_2mb", "huge_1gb"};
+    state.SetLabel(labels[int(region.pages())]);
+
+    uint64_t* slots = static_cast<uint64_t*>(region.data());
+    const size_t count = size / sizeof(uint64_t);
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < count; ++i) slots[i] = rng() % count;
+
+    uint64_t index = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 64; ++i) index = slots[index];
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetItemsProcessed(long(state.iterations()) * 64);
+}
+BENCHMARK(BM_RegionRandomRead)->Arg(int(page_size::normal))->Arg(int(page_size::transparent))->Arg(int(page_size::huge_2mb));
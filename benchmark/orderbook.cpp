@@ -0,0 +1,113 @@
+#include <random>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixbulk.hpp"
+#include "fixate/fixbook.hpp"
+#include "simulator.hpp"
+
+using namespace simulator;
+
+namespace {
+
+    /**
+     * Incremental feed around a random walking mid, levels within 64 ticks
+     * of it are added, resized and deleted.
+     */
+    std::string makeFeed(int messages)
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int> entries(1, 8), offset(0, 63), action(0, 9), walk(-1, 1);
+        std::uniform_real_distribution<double> size(0.1, 50.0);
+        MarketDataIncrementalRefresh md;
+        md.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+        md.set<SenderCompId>("FEED");
+        md.set<TargetCompId>("BOOK");
+        md.set<SendingTime>();
+        md.set<MDReqID>("REPLAY");
+        std::string feed;
+        char buffer[4096];
+        int64_t mid = 40000;
+        for (int m = 0; m < messages; ++m) {
+            mid += walk(rng);
+            int n = entries(rng);
+            md.set<MsgSeqNum>(m + 1);
+            md.set<NoMDEntries>(n);
+            md.resize<MDEntries>(n);
+            for (int i = 0; i < n; ++i) {
+                bool bid = i % 2 == 0;
+                int a = action(rng);
+                int ticks = 1 + offset(rng);
+                md.set<MDEntries, MDUpdateAction>(i, a < 3 ? '0' : a < 8 ? '1' : '2');
+                md.set<MDEntries, MDEntryType>(i, bid ? '0' : '1');
+                md.set<MDEntries, Symbol>(i, "BTC-PERPETUAL");
+                md.set<MDEntries, MDEntryPx>(i, 0.5 * (bid ? mid - ticks : mid + ticks), 1);
+                md.set<MDEntries, MDEntrySize>(i, size(rng), 1);
+            }
+            feed.append(buffer, md.dump(buffer, true, true));
+        }
+        return feed;
+    }
+
+    struct BookBuilder
+    {
+        OrderBook book;
+        MarketDataIncrementalRefresh md;
+        uint64_t topChanges = 0;
+        void operator()(MessageTypeEnum msgType, const char* buffer, size_t n)
+        {
+            if (msgType == MessageTypeEnum::MarketDataIncrementalRefresh) {
+                md.parse(buffer);
+                topChanges += book.onIncremental<MDEntries>(md);
+            }
+        }
+    };
+}
+
+/**
+ * Replay a recorded incremental feed through a FixEngine into an OrderBook,
+ * parsing included. Items are book updates (MDEntries entries).
+ */
+static void BM_OrderBookReplay(benchmark::State &state)
+{
+    const std::string feed = makeFeed(100000);
+    BookBuilder builder;
+    for (auto _ : state)
+    {
+        builder.book.clear();
+        mapped_chunk source(feed.data(), feed.data() + feed.size());
+        FixEngine<mapped_chunk, BookBuilder> engine(&source, &builder);
+        engine.connect();
+        while (source.active()) engine.perform();
+        benchmark::DoNotOptimize(builder.book.bestBid());
+    }
+    state.SetItemsProcessed(builder.book.updates());
+    state.counters["levels"] = builder.book.bids().size() + builder.book.offers().size();
+}
+BENCHMARK(BM_OrderBookReplay)->Unit(benchmark::kMillisecond);
+
+//! Book maintenance alone, on updates decoded up front.
+static void BM_OrderBookUpdate(benchmark::State &state)
+{
+    const std::string feed = makeFeed(100000);
+    struct Update { char type, action; double price, size; };
+    std::vector<Update> updates;
+    {
+        MarketDataIncrementalRefresh md;
+        for (const char* p = feed.data(); p < feed.data() + feed.size(); ) {
+            p += md.parse(p);
+            for (int64_t i = 0; i < md.get<NoMDEntries>(); ++i)
+                updates.push_back({md.get<MDEntries, MDEntryType>(i), md.get<MDEntries, MDUpdateAction>(i),
+                        md.get<MDEntries, MDEntryPx>(i), md.get<MDEntries, MDEntrySize>(i)});
+        }
+    }
+    OrderBook book;
+    for (auto _ : state)
+    {
+        book.clear();
+        for (const Update& u : updates) book.update(u.type, u.action, u.price, u.size);
+        benchmark::DoNotOptimize(book.bestOffer());
+    }
+    state.SetItemsProcessed(long(state.iterations()) * updates.size());
+}
+BENCHMARK(BM_OrderBookUpdate)->Unit(benchmark::kMillisecond);
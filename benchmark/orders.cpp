@@ -0,0 +1,130 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+
+#include "fixate/fixorders.hpp"
+#include "simulator.hpp"
+
+using namespace simulator;
+
+namespace {
+
+    const size_t LIVE_ORDERS = 1000000;
+
+    std::string clOrdID(size_t i) {
+        char id[32];
+        return std::string(id, snprintf(id, sizeof(id), "C%zu", 100000000 + i));
+    }
+
+    //! 1M acknowledged orders, with the ids to visit them in random order.
+    struct LiveOrders
+    {
+        OrderStore store{LIVE_ORDERS + 1024, memory_policy{page_size::transparent}};
+        std::vector<std::string> ids;
+        LiveOrders() {
+            NewOrderSingle order;
+            order.set<MessageType>(MessageTypeEnum::NewOrderSingle);
+            order.set<Side>('1');
+            order.set<OrderType>('2');
+            order.set<OrderQty>(100.0, 1);
+            order.set<Price>(100.5, 1);
+            ExecutionReport ack;
+            ack.set<MessageType>(MessageTypeEnum::ExecutionReport);
+            ack.set<ExecType>('0');
+            ack.set<OrderStatus>('0');
+            ack.set<CumQty>(0.0, 1);
+            ack.set<LeavesQty>(100.0, 1);
+            for (size_t i = 0; i < LIVE_ORDERS; ++i) {
+                ids.push_back(clOrdID(i));
+                order.set<ClOrdID>(ids.back());
+                store.onNewOrder(order);
+                ack.set<ClOrdID>(ids.back());
+                ack.set<OrderID>(std::to_string(i));
+                store.onExecutionReport(ack);
+            }
+            std::shuffle(ids.begin(), ids.end(), std::mt19937_64(3));
+        }
+    };
+}
+
+/**
+ * Partial fills applied to random orders out of 1M live ones, lookup by
+ * ClOrdID and update of OrdStatus/CumQty/LeavesQty/AvgPx.
+ */
+static void BM_OrderStoreFill(benchmark::State &state)
+{
+    LiveOrders live;
+    ExecutionReport fill;
+    fill.set<MessageType>(MessageTypeEnum::ExecutionReport);
+    fill.set<ExecType>('F');
+    fill.set<OrderStatus>('1');
+    fill.set<CumQty>(10.0, 1);
+    fill.set<LeavesQty>(90.0, 1);
+    fill.set<AvgPx>(100.5, 1);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        fill.set<ClOrdID>(live.ids[i]);
+        benchmark::DoNotOptimize(live.store.onExecutionReport(fill));
+        if (++i == live.ids.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["live"] = live.store.size();
+}
+BENCHMARK(BM_OrderStoreFill);
+
+//! Order life cycle at 1M live orders: new, ack and a full fill which retires it.
+static void BM_OrderStoreChurn(benchmark::State &state)
+{
+    LiveOrders live;
+    NewOrderSingle order;
+    order.set<MessageType>(MessageTypeEnum::NewOrderSingle);
+    order.set<OrderQty>(100.0, 1);
+    ExecutionReport report;
+    report.set<MessageType>(MessageTypeEnum::ExecutionReport);
+    std::vector<std::string> fresh;
+    for (size_t i = 0; i < 1024; ++i) fresh.push_back(clOrdID(LIVE_ORDERS + i));
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        order.set<ClOrdID>(fresh[i]);
+        live.store.onNewOrder(order);
+        report.set<ClOrdID>(fresh[i]);
+        report.set<OrderID>(fresh[i]);
+        report.set<ExecType>('0');
+        report.set<OrderStatus>('0');
+        live.store.onExecutionReport(report);
+        report.set<ExecType>('F');
+        report.set<OrderStatus>('2');
+        benchmark::DoNotOptimize(live.store.onExecutionReport(report));
+        if (++i == fresh.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["live"] = live.store.size();
+}
+BENCHMARK(BM_OrderStoreChurn);
+
+//! The fill lookup through std::unordered_map<std::string, OrderRecord>.
+static void BM_OrderHashMapFill(benchmark::State &state)
+{
+    LiveOrders live;
+    std::unordered_map<std::string, OrderRecord> orders;
+    for (const auto& id : live.ids) orders.emplace(id, OrderRecord{});
+    ExecutionReport fill;
+    fill.set<CumQty>(10.0, 1);
+    fill.set<LeavesQty>(90.0, 1);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        fill.set<ClOrdID>(live.ids[i]);
+        OrderRecord& r = orders.find(std::string(fill.get<ClOrdID>()))->second;
+        r.cumQty = fill.get<CumQty>();
+        r.leavesQty = fill.get<LeavesQty>();
+        benchmark::DoNotOptimize(r);
+        if (++i == live.ids.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderHashMapFill);
@@ -0,0 +1,120 @@
+#include <string>
+#include <cstdio>
+#include <benchmark/benchmark.h>
+
+#include "simulator.hpp"
+
+using namespace simulator;
+
+struct CountingVisitor
+{
+    uint64_t messages = 0;
+    void operator()(MessageTypeEnum msgType, const char* buffer, size_t n) { messages++; }
+};
+
+namespace {
+
+    void put16(std::string& out, uint16_t v) { out.push_back(char(v >> 8)); out.push_back(char(v)); }
+    void put32(std::string& out, uint32_t v) { put16(out, uint16_t(v >> 16)); put16(out, uint16_t(v)); }
+    template <typename T>
+    void putle(std::string& out, T v) { out.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+    //! An Ethernet, IPv4 and TCP frame of `payload` at `seq`, checksums are not filled.
+    void writeFrame(std::string& out, uint32_t seq, const char* payload, size_t len, int64_t ts)
+    {
+        std::string frame("\x02\0\0\0\0\x01\x02\0\0\0\0\x02\x08\x00", 14);
+        frame += std::string("\x45\x00", 2);
+        put16(frame, uint16_t(40 + len));
+        frame += std::string("\x00\x01\x40\x00\x40\x06\x00\x00\x0a\x00\x00\x02\x0a\x00\x00\x01", 16);
+        put16(frame, 9880); put16(frame, 40000);
+        put32(frame, seq); put32(frame, 0);
+        frame += std::string("\x50\x18\xff\xff\x00\x00\x00\x00", 8);
+        frame.append(payload, len);
+        putle<uint32_t>(out, uint32_t(ts / 1000000000LL));
+        putle<uint32_t>(out, uint32_t(ts % 1000000000LL / 1000));
+        putle<uint32_t>(out, uint32_t(frame.size()));
+        putle<uint32_t>(out, uint32_t(frame.size()));
+        out += frame;
+    }
+
+    /**
+     * A capture of one session carrying 100k market data messages in 1448
+     * byte segments. With `disorder`, every 64th segment swaps places with
+     * the next and every 100th is sent twice.
+     */
+    std::string writeCapture(bool disorder, size_t& streamBytes)
+    {
+        std::string stream;
+        char buffer[2048];
+        MarketDataIncrementalRefresh md;
+        md.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+        md.set<SenderCompId>("EXCHANGE");
+        md.set<TargetCompId>("CAPTURE");
+        md.set<MDReqID>("PCAP");
+        md.set<NoMDEntries>(4);
+        md.resize<MDEntries>(4);
+        for (int i = 0; i < 100000; ++i) {
+            md.set<MsgSeqNum>(i);
+            md.set<SendingTime>();
+            for (int j = 0; j < 4; ++j) {
+                md.set<MDEntries, MDUpdateAction>(j, '1');
+                md.set<MDEntries, MDEntryType>(j, j % 2 ? '1' : '0');
+                md.set<MDEntries, Symbol>(j, "BTC-PERPETUAL");
+                md.set<MDEntries, MDEntryPx>(j, 100.0 + (i + j) % 64, 2);
+                md.set<MDEntries, MDEntrySize>(j, 1.0 + j, 1);
+            }
+            stream.append(buffer, md.dump(buffer, true, true));
+        }
+        streamBytes = stream.size();
+
+        const size_t mss = 1448;
+        const uint32_t isn = 1000;
+        std::string capture;
+        putle<uint32_t>(capture, 0xa1b2c3d4);
+        putle<uint16_t>(capture, 2); putle<uint16_t>(capture, 4);
+        putle<uint32_t>(capture, 0); putle<uint32_t>(capture, 0);
+        putle<uint32_t>(capture, 65535); putle<uint32_t>(capture, 1);
+        int64_t ts = 1735689600000000000LL;
+        size_t segments = (stream.size() + mss - 1) / mss;
+        for (size_t s = 0; s < segments; ++s) {
+            size_t k = s;
+            if (disorder && s % 64 == 0 && s + 1 < segments) k = s + 1;
+            else if (disorder && s % 64 == 1) k = s - 1;
+            size_t off = k * mss, len = std::min(mss, stream.size() - off);
+            writeFrame(capture, isn + uint32_t(off), stream.data() + off, len, ts += 1000);
+            if (disorder && s % 100 == 0) writeFrame(capture, isn + uint32_t(off), stream.data() + off, len, ts += 1000);
+        }
+        return capture;
+    }
+}
+
+static void BM_PcapReplay(benchmark::State &state)
+{
+    size_t streamBytes = 0;
+    std::string capture = writeCapture(state.range(0), streamBytes);
+    char filename[] = "/tmp/fixate-bench-XXXXXX";
+    int fd = mkstemp(filename);
+    if (fd < 0 || write(fd, capture.data(), capture.size()) != ssize_t(capture.size())) {
+        state.SkipWithError("Failed to write the capture");
+        return;
+    }
+    close(fd);
+
+    uint64_t messages = 0;
+    for (auto _ : state)
+    {
+        pcap_client source(filename, flow_filter());
+        CountingVisitor visitor;
+        FixEngine<pcap_client, CountingVisitor> engine(&source, &visitor);
+        try {
+            engine.connect();
+            while (source.active()) engine.perform();
+        }
+        catch (const connection_exception&) {}
+        messages += visitor.messages;
+    }
+    unlink(filename);
+    state.SetItemsProcessed(long(messages));
+    state.SetBytesProcessed(long(state.iterations()) * long(streamBytes));
+}
+BENCHMARK(BM_PcapReplay)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
@@ -0,0 +1,71 @@
+#include <cstring>
+#include <benchmark/benchmark.h>
+#include <ringbuffer/ringbuffer.h>
+
+#include "fixate/ringbuffer.hpp"
+
+using namespace fixate;
+
+static constexpr const int RING_CAPACITY = 1 << 20;
+
+/**
+ * Receive path pattern of a connection, a read lands at the tail, then the
+ * engine peeks the head, checks the size and consumes a message.
+ */
+static void BM_RingVrbLibrary(benchmark::State &state)
+{
+    const int n = state.range(0);
+    char message[4096];
+    std::memset(message, 'A', sizeof(message));
+    vrb_ctx_t* ctx = vrb_ctx_create(RING_CAPACITY, "fixate-bench-vrb");
+    for (auto _ : state)
+    {
+        std::memcpy(vrb_prefetch_tail(ctx), message, n);
+        vrb_move_tail(ctx, n);
+        while (vrb_size(ctx) >= n) {
+            benchmark::DoNotOptimize(*vrb_prefetch_head(ctx));
+            vrb_move_head(ctx, n);
+        }
+    }
+    vrb_ctx_destroy(ctx);
+    state.SetBytesProcessed(long(state.iterations()) * n);
+}
+BENCHMARK(BM_RingVrbLibrary)->Arg(64)->Arg(512)->Arg(4096);
+
+static void BM_RingRuntimeCapacity(benchmark::State &state)
+{
+    const int n = state.range(0);
+    char message[4096];
+    std::memset(message, 'A', sizeof(message));
+    ring_buffer<> ring(RING_CAPACITY, "fixate-bench-ring");
+    for (auto _ : state)
+    {
+        std::memcpy(ring.prefetch_tail(), message, n);
+        ring.move_tail(n);
+        while (ring.size() >= n) {
+            benchmark::DoNotOptimize(*ring.prefetch_head());
+            ring.move_head(n);
+        }
+    }
+    state.SetBytesProcessed(long(state.iterations()) * n);
+}
+BENCHMARK(BM_RingRuntimeCapacity)->Arg(64)->Arg(512)->Arg(4096);
+
+static void BM_RingStaticCapacity(benchmark::State &state)
+{
+    const int n = state.range(0);
+    char message[4096];
+    std::memset(message, 'A', sizeof(message));
+    ring_buffer<RING_CAPACITY> ring;
+    for (auto _ : state)
+    {
+        std::memcpy(ring.prefetch_tail(), message, n);
+        ring.move_tail(n);
+        while (ring.size() >= n) {
+            benchmark::DoNotOptimize(*ring.prefetch_head());
+            ring.move_head(n);
+        }
+    }
+    state.SetBytesProcessed(long(state.iterations()) * n);
+}
+BENCHMARK(BM_RingStaticCapacity)->Arg(64)->Arg(512)->Arg(4096);
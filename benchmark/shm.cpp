@@ -0,0 +1,90 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <benchmark/benchmark.h>
+
+#include "simulator.hpp"
+
+using namespace simulator;
+
+/**
+ * Strategy side of the fan-out, counts the market data updates it parses
+ * straight out of the shared memory ring.
+ */
+struct FanOutConsumer
+{
+    std::atomic<uint64_t> updates{0};
+    MarketDataIncrementalRefresh msg;
+    void operator()(MessageTypeEnum msgType, const char* buffer, size_t n)
+    {
+        if (msgType == MessageTypeEnum::MarketDataIncrementalRefresh) {
+            msg.parse(buffer);
+            updates.fetch_add(1, std::memory_order_release);
+        }
+    }
+};
+
+static void BM_ShmFanOut(benchmark::State &state)
+{
+    const int consumers = state.range(0);
+    const int batch = 64;
+    const std::string name = "fixate-bench-fanout";
+
+    MarketDataIncrementalRefresh md;
+    md.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+    md.set<SenderCompId>("FEEDHANDLER");
+    md.set<TargetCompId>("STRATEGY");
+    md.set<SendingTime>();
+    md.set<MDReqID>("FANOUT");
+    md.set<NoMDEntries>(4);
+    md.resize<MDEntries>(4);
+    for (int i = 0; i < 4; ++i) {
+        md.set<MDEntries, MDUpdateAction>(i, '1');
+        md.set<MDEntries, MDEntryType>(i, i % 2 ? '1' : '0');
+        md.set<MDEntries, Symbol>(i, "BTC-PERPETUAL");
+        md.set<MDEntries, MDEntryPx>(i, 100.0 + i, 2);
+        md.set<MDEntries, MDEntrySize>(i, 1.0 + i, 1);
+    }
+    char buffer[1024];
+
+    shm_publisher publisher(name, shm_publisher::DEFAULT_CAPACITY, [](){}, [](){}, [](int, const std::string&){});
+    publisher.connect();
+
+    std::atomic<bool> running{true};
+    std::atomic<int> ready{0};
+    std::vector<std::unique_ptr<FanOutConsumer>> visitors;
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        visitors.emplace_back(std::make_unique<FanOutConsumer>());
+        FanOutConsumer* visitor = visitors.back().get();
+        threads.emplace_back([&, visitor]() {
+            shm_client source(name, [](){}, [](){}, [](int, const std::string&){});
+            FixEngine<shm_client, FanOutConsumer> engine(&source, visitor);
+            engine.connect();
+            ready++;
+            while (running.load(std::memory_order_relaxed)) {
+                if (!engine.perform()) std::this_thread::yield();
+            }
+        });
+    }
+    while (ready.load() != consumers) std::this_thread::yield();
+
+    uint64_t published = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < batch; ++i) {
+            md.set<MsgSeqNum>(int(++published));
+            int bytes = md.dump(buffer, true, true);
+            publisher.send_message(buffer, bytes);
+        }
+        for (auto& v : visitors) {
+            while (v->updates.load(std::memory_order_acquire) < published) std::this_thread::yield();
+        }
+    }
+    running = false;
+    for (auto& t : threads) t.join();
+    publisher.disconnect();
+    state.SetItemsProcessed(long(state.iterations()) * batch * consumers);
+}
+BENCHMARK(BM_ShmFanOut)->UseRealTime()->Arg(1)->Arg(2)->Arg(4);
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include "fixate/fixate.hpp"
+
+namespace simulator {
+
+    using namespace fixate;
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime,
+        EncryptMethod, HeartBtInt
+    > Logon;
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime,
+        ClOrdID, Symbol, Side, OrderQty, OrderType, Price
+    > NewOrderSingle;
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime,
+        OrderID, ClOrdID, ExecID, ExecType, OrderStatus, Symbol, Side,
+        OrderQty, Price, LeavesQty, CumQty, AvgPx
+    > ExecutionReport;
+
+    using MDEntries = TvpVector<TvpGroup<MDUpdateAction, MDEntryType, Symbol, MDEntryPx, MDEntrySize>>;
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime,
+        MDReqID, NoMDEntries, MDEntries
+    > MarketDataIncrementalRefresh;
+
+    struct SimulatorConf
+    {
+        std::string localAddress = "127.0.0.1";
+        int port = 19881;
+        std::string senderCompId = "SIMULATOR";
+        std::string targetCompId = "CLIENT";
+        std::string symbol = "BTC-PERPETUAL";
+        //! Interval between two market data updates, 0 disables the feed.
+        int64_t marketDataIntervalNs = 0;
+        //! Number of price levels carried by every market data update.
+        int marketDataEntries = 4;
+        //! How long `accept` waits for the client, so a failed run ends instead of hanging.
+        int acceptTimeoutMs = 5000;
+    };
+
+    /**
+     * A minimal exchange which accepts a single FIX session on the loopback
+     * interface. It answers Logon, acknowledges every NewOrderSingle with a
+     * new ExecutionReport, and once logged on publishes synthetic
+     * MarketDataIncrementalRefresh messages at the configured rate.
+     */
+    class ExchangeSimulator
+    {
+    public:
+        typedef tcp_server DataSourceType;
+        typedef FixEngine<tcp_server, ExchangeSimulator> FixEngineType;
+    public:
+        ExchangeSimulator(const SimulatorConf& conf)
+            : mConf(conf),
+              mDataSource(conf.localAddress, conf.port, [](){}, [](){},
+                    [](int, const std::string&){}),
+              mFixEngine(&mDataSource, this) { mDataSource.set_accept_timeout(conf.acceptTimeoutMs); }
+        ExchangeSimulator(const ExchangeSimulator& other) = delete;
+        ExchangeSimulator& operator=(const ExchangeSimulator& other) = delete;
+
+        //! Bind and listen, so that clients can connect before `accept` is called.
+        bool listen() { return mDataSource.listen() >= 0; }
+        //! Block until a client connects, false if none did within `acceptTimeoutMs`.
+        bool accept() { return mFixEngine.connect(); }
+        bool active() const { return mDataSource.active(); }
+        bool perform() {
+            bool processed = mFixEngine.perform();
+            if (mIsLoggedOn && mConf.marketDataIntervalNs > 0) {
+                int64_t now = epoch_timestamp();
+                if (now >= mNextMarketDataTs) {
+                    publishMarketData(now);
+                    mNextMarketDataTs = now + mConf.marketDataIntervalNs;
+                }
+            }
+            return processed;
+        }
+        void run(const std::atomic<bool>& running) {
+            while (running.load(std::memory_order_relaxed) && active()) { perform(); }
+        }
+        uint64_t ordersAcknowledged() const { return mOrdersAcknowledged; }
+        uint64_t marketDataPublished() const { return mMarketDataPublished; }
+
+        void operator()(MessageTypeEnum msgType, const char* buffer, size_t n)
+        {
+            if (msgType == MessageTypeEnum::Logon) {
+                Logon request;
+                request.parse(buffer);
+                Logon response;
+                response.set<MessageType>(MessageTypeEnum::Logon);
+                response.set<EncryptMethod>('0');
+                response.set<HeartBtInt>(request.get<HeartBtInt>());
+                sendmsg(response, epoch_timestamp());
+                mIsLoggedOn = true;
+                mNextMarketDataTs = epoch_timestamp();
+            }
+            else if (msgType == MessageTypeEnum::NewOrderSingle) {
+                mOrder.parse(buffer);
+                mReport.set<MessageType>(MessageTypeEnum::ExecutionReport);
+                mReport.set<OrderID>(details::itoa(++mOrderId));
+                mReport.set<ClOrdID>(mOrder.get<ClOrdID>());
+                mReport.set<ExecID>(details::itoa(++mExecId));
+                mReport.set<ExecType>('0');
+                mReport.set<OrderStatus>('0');
+                mReport.set<Symbol>(mOrder.get<Symbol>());
+                mReport.set<Side>(mOrder.get<Side>());
+                mReport.set<OrderQty>(mOrder.get<OrderQty>(), 2);
+                mReport.set<Price>(mOrder.get<Price>(), 2);
+                mReport.set<LeavesQty>(mOrder.get<OrderQty>(), 2);
+                mReport.set<CumQty>(0.0, 1);
+                mReport.set<AvgPx>(0.0, 1);
+                sendmsg(mReport, epoch_timestamp());
+                mOrdersAcknowledged++;
+            }
+            else if (msgType == MessageTypeEnum::Logout) {
+                mIsLoggedOn = false;
+            }
+        }
+    private:
+        template <typename TFixMessage>
+        size_t sendmsg(TFixMessage& msg, int64_t timestamp) {
+            msg.template set<MsgSeqNum>(++mOutMsgSeqNum);
+            msg.template set<SenderCompId>(mConf.senderCompId);
+            msg.template set<TargetCompId>(mConf.targetCompId);
+            msg.template set<SendingTime>(timestamp);
+            return mFixEngine.sendmsg(msg);
+        }
+        void publishMarketData(int64_t timestamp) {
+            int entries = mConf.marketDataEntries;
+            mMarketData.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+            mMarketData.set<MDReqID>(details::itoa(mMarketDataPublished));
+            mMarketData.set<NoMDEntries>(entries);
+            mMarketData.resize<MDEntries>(entries);
+            double mid = 100.0 + double(mMarketDataPublished % 64);
+            for (int i = 0; i < entries; ++i) {
+                bool bid = (i % 2) == 0;
+                mMarketData.set<MDEntries, MDUpdateAction>(i, '1');
+                mMarketData.set<MDEntries, MDEntryType>(i, bid ? '0' : '1');
+                mMarketData.set<MDEntries, Symbol>(i, mConf.symbol);
+                mMarketData.set<MDEntries, MDEntryPx>(i, bid ? mid - 0.5 * (i + 1) : mid + 0.5 * (i + 1), 2);
+                mMarketData.set<MDEntries, MDEntrySize>(i, double(1 + i), 1);
+            }
+            sendmsg(mMarketData, timestamp);
+            mMarketDataPublished++;
+        }
+    private:
+        SimulatorConf mConf;
+        DataSourceType mDataSource;
+        FixEngineType mFixEngine;
+        NewOrderSingle mOrder;
+        ExecutionReport mReport;
+        MarketDataIncrementalRefresh mMarketData;
+        bool mIsLoggedOn = false;
+        int mOutMsgSeqNum = 0;
+        int64_t mOrderId = 0;
+        int64_t mExecId = 0;
+        int64_t mNextMarketDataTs = 0;
+        uint64_t mOrdersAcknowledged = 0;
+        uint64_t mMarketDataPublished = 0;
+    };
+
+}
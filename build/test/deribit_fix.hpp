@@ -0,0 +1,467 @@
+/**
+* @file deribit.hpp
+*
+* Generated by tools/fixgen.py from FIX44.xml, deribit.xml, do not edit.
+*/
+#ifndef FIXATE_GENERATED_DERIBIT_HPP_
+#define FIXATE_GENERATED_DERIBIT_HPP_
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsubobject-linkage"
+
+#include <string_view>
+#include "fixate/fixmessage.hpp"
+
+namespace fixate { namespace deribit {
+
+    // Fields fixate doesn't define.
+    static constexpr const char* TagCancelOnDisconnect = "9001";
+    static constexpr const char* TagUnsubscribeExecutionReports = "9009";
+    static constexpr const char* TagConnectionOnlyExecutionReports = "9010";
+    static constexpr const char* TagCancelOnDisconnectType = "35002";
+    static constexpr const char* TagDeribitTradeAmount = "100007";
+    static constexpr const char* TagTradeVolume24h = "100087";
+    static constexpr const char* TagMarkPrice = "100090";
+    static constexpr const char* TagCurrentFunding = "100092";
+    static constexpr const char* TagFunding8h = "100093";
+    static constexpr const char* TagDeribitTradeId = "100009";
+    static constexpr const char* TagDeribitLabel = "100010";
+    static constexpr const char* TagDeribitLiquidation = "100091";
+    struct CancelOnDisconnect : public TvpChar<&TagCancelOnDisconnect> {};
+    struct UnsubscribeExecutionReports : public TvpChar<&TagUnsubscribeExecutionReports> {};
+    struct ConnectionOnlyExecutionReports : public TvpChar<&TagConnectionOnlyExecutionReports> {};
+    struct CancelOnDisconnectType : public TvpChar<&TagCancelOnDisconnectType> {};
+    struct DeribitTradeAmount : public TvpInteger<int, 16, &TagDeribitTradeAmount> {};
+    struct TradeVolume24h : public TvpFloat<double, 32, &TagTradeVolume24h> {};
+    struct MarkPrice : public TvpFloat<double, 32, &TagMarkPrice> {};
+    struct CurrentFunding : public TvpFloat<double, 32, &TagCurrentFunding> {};
+    struct Funding8h : public TvpFloat<double, 32, &TagFunding8h> {};
+    struct DeribitTradeId : public TvpStringFixed<32, &TagDeribitTradeId> {};
+    struct DeribitLabel : public TvpStringFixed<64, &TagDeribitLabel> {};
+    struct DeribitLiquidation : public TvpStringFixed<4, &TagDeribitLiquidation> {};
+
+    // Fields fixate defines under another name.
+    using SenderCompID = ::fixate::SenderCompId;
+    using TargetCompID = ::fixate::TargetCompId;
+    using TestReqID = ::fixate::TestReqId;
+    using UnderlyingPx = ::fixate::UnderlyingPrice;
+
+    enum class EncryptMethodEnum : char {
+        NoneOther = '0',
+    };
+    enum class CancelOnDisconnectTypeEnum : char {
+        Default = '0',
+        Session = '1',
+        Account = '2',
+    };
+    enum class SubscriptionRequestTypeEnum : char {
+        Snapshot = '0',
+        SnapshotPlusUpdates = '1',
+    };
+    enum class MDEntryTypeEnum : char {
+        Bid = '0',
+        Offer = '1',
+        Trade = '2',
+    };
+    enum class MDUpdateActionEnum : char {
+        New = '0',
+        Change = '1',
+        Delete = '2',
+    };
+
+    //! Whether a field of the dialect has `tag`.
+    inline bool dialect_tag(int tag) {
+        switch (tag) {
+        case 8: case 9: case 10: case 34: case 35: case 43: case 48: case 49: case 52: case 55:
+        case 56: case 58: case 95: case 96: case 97: case 98: case 108: case 112: case 146: case 201:
+        case 231: case 262: case 263: case 264: case 265: case 267: case 268: case 269: case 270: case 271:
+        case 279: case 311: case 553: case 554: case 746: case 810: case 880: case 1409: case 9001: case 9009:
+        case 9010: case 35002: case 100007: case 100009: case 100010: case 100087: case 100090: case 100091: case 100092: case 100093:
+            return true;
+        }
+        return false;
+    }
+
+    // Repeating groups. An entry starts with its delimiter and ends at the next one or at another
+    // tag of the dialect, tags the dialect doesn't have are stepped over.
+    struct MDEntryTypesEntry : public TvpGroup<MDEntryType> {
+        int parse(TvpParseData& pd) {
+            int bR = field<MDEntryType>().parse(pd);
+            for (;;) {
+                int tag = peek_tag(pd.buffer);
+                switch (tag) {
+                case 269: case -1: return bR;
+                default:
+                    if (dialect_tag(tag)) return bR;
+                    bR += skip_field(pd);
+                    break;
+                }
+            }
+        }
+    };
+    using MDEntryTypesGroup = TvpVector<MDEntryTypesEntry>;
+    struct RelatedSymEntry : public TvpGroup<Symbol, SecurityID> {
+        int parse(TvpParseData& pd) {
+            int bR = field<Symbol>().parse(pd);
+            for (;;) {
+                int tag = peek_tag(pd.buffer);
+                switch (tag) {
+                case 48: bR += field<SecurityID>().parse(pd); break;
+                case 55: case -1: return bR;
+                default:
+                    if (dialect_tag(tag)) return bR;
+                    bR += skip_field(pd);
+                    break;
+                }
+            }
+        }
+    };
+    using RelatedSymGroup = TvpVector<RelatedSymEntry>;
+    struct MDEntriesEntry : public TvpGroup<MDEntryType, MDEntryPx, MDEntrySize, DeribitTradeId, DeribitLabel, DeribitLiquidation, TrdMatchID> {
+        int parse(TvpParseData& pd) {
+            int bR = field<MDEntryType>().parse(pd);
+            for (;;) {
+                int tag = peek_tag(pd.buffer);
+                switch (tag) {
+                case 270: bR += field<MDEntryPx>().parse(pd); break;
+                case 271: bR += field<MDEntrySize>().parse(pd); break;
+                case 100009: bR += field<DeribitTradeId>().parse(pd); break;
+                case 100010: bR += field<DeribitLabel>().parse(pd); break;
+                case 100091: bR += field<DeribitLiquidation>().parse(pd); break;
+                case 880: bR += field<TrdMatchID>().parse(pd); break;
+                case 269: case -1: return bR;
+                default:
+                    if (dialect_tag(tag)) return bR;
+                    bR += skip_field(pd);
+                    break;
+                }
+            }
+        }
+    };
+    using MDEntriesGroup = TvpVector<MDEntriesEntry>;
+    struct MarketDataIncrementalRefreshMDEntriesEntry : public TvpGroup<MDUpdateAction, MDEntryType, Symbol, SecurityID, MDEntryPx, MDEntrySize, DeribitTradeId, DeribitLabel, DeribitLiquidation, TrdMatchID> {
+        int parse(TvpParseData& pd) {
+            int bR = field<MDUpdateAction>().parse(pd);
+            for (;;) {
+                int tag = peek_tag(pd.buffer);
+                switch (tag) {
+                case 269: bR += field<MDEntryType>().parse(pd); break;
+                case 55: bR += field<Symbol>().parse(pd); break;
+                case 48: bR += field<SecurityID>().parse(pd); break;
+                case 270: bR += field<MDEntryPx>().parse(pd); break;
+                case 271: bR += field<MDEntrySize>().parse(pd); break;
+                case 100009: bR += field<DeribitTradeId>().parse(pd); break;
+                case 100010: bR += field<DeribitLabel>().parse(pd); break;
+                case 100091: bR += field<DeribitLiquidation>().parse(pd); break;
+                case 880: bR += field<TrdMatchID>().parse(pd); break;
+                case 279: case -1: return bR;
+                default:
+                    if (dialect_tag(tag)) return bR;
+                    bR += skip_field(pd);
+                    break;
+                }
+            }
+        }
+    };
+    using MarketDataIncrementalRefreshMDEntriesGroup = TvpVector<MarketDataIncrementalRefreshMDEntriesEntry>;
+
+    struct Header : public TvpGroup<
+        SenderCompID, TargetCompID, MsgSeqNum, PossDupFlag, SendingTime, PossResend
+    > {};
+
+    //! A message of the dialect, its MsgType rendered at compile time.
+    template <const char* const* MsgTypeValue, typename ... TvpTypes>
+    struct Message : public FixMessage<FixVersionType::FIX_4_4, TvpConstant<&TagMessageType, MsgTypeValue>, Header, TvpTypes...> {
+        typedef FixMessage<FixVersionType::FIX_4_4, TvpConstant<&TagMessageType, MsgTypeValue>, Header, TvpTypes...> Base;
+        using MsgType = TvpConstant<&TagMessageType, MsgTypeValue>;
+        Message() : Base() {}
+    };
+
+    enum class MsgTypeEnum : uint16_t
+    {
+        Heartbeat = 0,
+        TestRequest,
+        Logon,
+        Logout,
+        MarketDataRequest,
+        MarketDataSnapshotFullRefresh,
+        MarketDataIncrementalRefresh,
+    };
+
+    static constexpr const char* M_Heartbeat = "0";
+    static constexpr const char* M_TestRequest = "1";
+    static constexpr const char* M_Logon = "A";
+    static constexpr const char* M_Logout = "5";
+    static constexpr const char* M_MarketDataRequest = "V";
+    static constexpr const char* M_MarketDataSnapshotFullRefresh = "W";
+    static constexpr const char* M_MarketDataIncrementalRefresh = "X";
+
+    //! MsgType string of a message of the dialect.
+    inline const char* MsgTypeEnumToString(MsgTypeEnum val) {
+        switch (val) {
+        case MsgTypeEnum::Heartbeat: return M_Heartbeat;
+        case MsgTypeEnum::TestRequest: return M_TestRequest;
+        case MsgTypeEnum::Logon: return M_Logon;
+        case MsgTypeEnum::Logout: return M_Logout;
+        case MsgTypeEnum::MarketDataRequest: return M_MarketDataRequest;
+        case MsgTypeEnum::MarketDataSnapshotFullRefresh: return M_MarketDataSnapshotFullRefresh;
+        case MsgTypeEnum::MarketDataIncrementalRefresh: return M_MarketDataIncrementalRefresh;
+        }
+        return "";
+    }
+    //! Message of the dialect for a MsgType value, `MsgTypeEnum(-1)` if it has none.
+    inline MsgTypeEnum MsgTypeStringToEnum(std::string_view str) {
+        switch (str.size()) {
+        case 1:
+            switch (uint8_t(str[0])) {
+            case 0x30: return MsgTypeEnum::Heartbeat;
+            case 0x31: return MsgTypeEnum::TestRequest;
+            case 0x41: return MsgTypeEnum::Logon;
+            case 0x35: return MsgTypeEnum::Logout;
+            case 0x56: return MsgTypeEnum::MarketDataRequest;
+            case 0x57: return MsgTypeEnum::MarketDataSnapshotFullRefresh;
+            case 0x58: return MsgTypeEnum::MarketDataIncrementalRefresh;
+            }
+            break;
+        }
+        return MsgTypeEnum(-1);
+    }
+
+    struct Heartbeat : public Message<
+        &M_Heartbeat, TestReqID
+    > {
+        typedef Message<&M_Heartbeat, TestReqID> Base;
+        static constexpr const MsgTypeEnum Type = MsgTypeEnum::Heartbeat;
+        Heartbeat() : Base() {}
+        int parse(const char* src) { return Base::parse<Heartbeat>(src); }
+        static int parse_body(Base::Body& body, TvpParseData& pd) {
+            int bR = 0;
+            for (;;) {
+                switch (peek_tag(pd.buffer)) {
+                case 35: bR += body.field<Base::MsgType>().parse(pd); break;
+                case 49: bR += body.field<SenderCompID>().parse(pd); break;
+                case 56: bR += body.field<TargetCompID>().parse(pd); break;
+                case 34: bR += body.field<MsgSeqNum>().parse(pd); break;
+                case 43: bR += body.field<PossDupFlag>().parse(pd); break;
+                case 52: bR += body.field<SendingTime>().parse(pd); break;
+                case 97: bR += body.field<PossResend>().parse(pd); break;
+                case 112: bR += body.field<TestReqID>().parse(pd); break;
+                case 10: case -1: return bR;
+                default: bR += skip_field(pd); break;
+                }
+            }
+        }
+    };
+
+    struct TestRequest : public Message<
+        &M_TestRequest, TestReqID
+    > {
+        typedef Message<&M_TestRequest, TestReqID> Base;
+        static constexpr const MsgTypeEnum Type = MsgTypeEnum::TestRequest;
+        TestRequest() : Base() {}
+        int parse(const char* src) { return Base::parse<TestRequest>(src); }
+        static int parse_body(Base::Body& body, TvpParseData& pd) {
+            int bR = 0;
+            for (;;) {
+                switch (peek_tag(pd.buffer)) {
+                case 35: bR += body.field<Base::MsgType>().parse(pd); break;
+                case 49: bR += body.field<SenderCompID>().parse(pd); break;
+                case 56: bR += body.field<TargetCompID>().parse(pd); break;
+                case 34: bR += body.field<MsgSeqNum>().parse(pd); break;
+                case 43: bR += body.field<PossDupFlag>().parse(pd); break;
+                case 52: bR += body.field<SendingTime>().parse(pd); break;
+                case 97: bR += body.field<PossResend>().parse(pd); break;
+                case 112: bR += body.field<TestReqID>().parse(pd); break;
+                case 10: case -1: return bR;
+                default: bR += skip_field(pd); break;
+                }
+            }
+        }
+    };
+
+    struct Logon : public Message<
+        &M_Logon, EncryptMethod, HeartBtInt, RawDataLength, RawData, Username, Password, CancelOnDisconnect, UnsubscribeExecutionReports, ConnectionOnlyExecutionReports, CancelOnDisconnectType
+    > {
+        typedef Message<&M_Logon, EncryptMethod, HeartBtInt, RawDataLength, RawData, Username, Password, CancelOnDisconnect, UnsubscribeExecutionReports, ConnectionOnlyExecutionReports, CancelOnDisconnectType> Base;
+        static constexpr const MsgTypeEnum Type = MsgTypeEnum::Logon;
+        Logon() : Base() {}
+        int parse(const char* src) { return Base::parse<Logon>(src); }
+        static int parse_body(Base::Body& body, TvpParseData& pd) {
+            int bR = 0;
+            for (;;) {
+                switch (peek_tag(pd.buffer)) {
+                case 35: bR += body.field<Base::MsgType>().parse(pd); break;
+                case 49: bR += body.field<SenderCompID>().parse(pd); break;
+                case 56: bR += body.field<TargetCompID>().parse(pd); break;
+                case 34: bR += body.field<MsgSeqNum>().parse(pd); break;
+                case 43: bR += body.field<PossDupFlag>().parse(pd); break;
+                case 52: bR += body.field<SendingTime>().parse(pd); break;
+                case 97: bR += body.field<PossResend>().parse(pd); break;
+                case 98: bR += body.field<EncryptMethod>().parse(pd); break;
+                case 108: bR += body.field<HeartBtInt>().parse(pd); break;
+                case 95: bR += body.field<RawDataLength>().parse(pd); break;
+                case 96: bR += body.field<RawData>().parse(pd); break;
+                case 553: bR += body.field<Username>().parse(pd); break;
+                case 554: bR += body.field<Password>().parse(pd); break;
+                case 9001: bR += body.field<CancelOnDisconnect>().parse(pd); break;
+                case 9009: bR += body.field<UnsubscribeExecutionReports>().parse(pd); break;
+                case 9010: bR += body.field<ConnectionOnlyExecutionReports>().parse(pd); break;
+                case 35002: bR += body.field<CancelOnDisconnectType>().parse(pd); break;
+                case 10: case -1: return bR;
+                default: bR += skip_field(pd); break;
+                }
+            }
+        }
+    };
+
+    struct Logout : public Message<
+        &M_Logout, Text, SessionStatus
+    > {
+        typedef Message<&M_Logout, Text, SessionStatus> Base;
+        static constexpr const MsgTypeEnum Type = MsgTypeEnum::Logout;
+        Logout() : Base() {}
+        int parse(const char* src) { return Base::parse<Logout>(src); }
+        static int parse_body(Base::Body& body, TvpParseData& pd) {
+            int bR = 0;
+            for (;;) {
+                switch (peek_tag(pd.buffer)) {
+                case 35: bR += body.field<Base::MsgType>().parse(pd); break;
+                case 49: bR += body.field<SenderCompID>().parse(pd); break;
+                case 56: bR += body.field<TargetCompID>().parse(pd); break;
+                case 34: bR += body.field<MsgSeqNum>().parse(pd); break;
+                case 43: bR += body.field<PossDupFlag>().parse(pd); break;
+                case 52: bR += body.field<SendingTime>().parse(pd); break;
+                case 97: bR += body.field<PossResend>().parse(pd); break;
+                case 58: bR += body.field<Text>().parse(pd); break;
+                case 1409: bR += body.field<SessionStatus>().parse(pd); break;
+                case 10: case -1: return bR;
+                default: bR += skip_field(pd); break;
+                }
+            }
+        }
+    };
+
+    struct MarketDataRequest : public Message<
+        &M_MarketDataRequest, MDReqID, SubscriptionRequestType, MarketDepth, MDUpdateType, DeribitTradeAmount, NoMDEntryTypes, MDEntryTypesGroup, NoRelatedSym, RelatedSymGroup
+    > {
+        typedef Message<&M_MarketDataRequest, MDReqID, SubscriptionRequestType, MarketDepth, MDUpdateType, DeribitTradeAmount, NoMDEntryTypes, MDEntryTypesGroup, NoRelatedSym, RelatedSymGroup> Base;
+        static constexpr const MsgTypeEnum Type = MsgTypeEnum::MarketDataRequest;
+        MarketDataRequest() : Base() {}
+        int parse(const char* src) { return Base::parse<MarketDataRequest>(src); }
+        static int parse_body(Base::Body& body, TvpParseData& pd) {
+            int bR = 0;
+            for (;;) {
+                switch (peek_tag(pd.buffer)) {
+                case 35: bR += body.field<Base::MsgType>().parse(pd); break;
+                case 49: bR += body.field<SenderCompID>().parse(pd); break;
+                case 56: bR += body.field<TargetCompID>().parse(pd); break;
+                case 34: bR += body.field<MsgSeqNum>().parse(pd); break;
+                case 43: bR += body.field<PossDupFlag>().parse(pd); break;
+                case 52: bR += body.field<SendingTime>().parse(pd); break;
+                case 97: bR += body.field<PossResend>().parse(pd); break;
+                case 262: bR += body.field<MDReqID>().parse(pd); break;
+                case 263: bR += body.field<SubscriptionRequestType>().parse(pd); break;
+                case 264: bR += body.field<MarketDepth>().parse(pd); break;
+                case 265: bR += body.field<MDUpdateType>().parse(pd); break;
+                case 100007: bR += body.field<DeribitTradeAmount>().parse(pd); break;
+                case 267:
+                    bR += body.field<NoMDEntryTypes>().parse(pd);
+                    pd.meta = body.field<NoMDEntryTypes>().get();
+                    bR += body.field<MDEntryTypesGroup>().parse(pd);
+                    break;
+                case 146:
+                    bR += body.field<NoRelatedSym>().parse(pd);
+                    pd.meta = body.field<NoRelatedSym>().get();
+                    bR += body.field<RelatedSymGroup>().parse(pd);
+                    break;
+                case 10: case -1: return bR;
+                default: bR += skip_field(pd); break;
+                }
+            }
+        }
+    };
+
+    struct MarketDataSnapshotFullRefresh : public Message<
+        &M_MarketDataSnapshotFullRefresh, MDReqID, Symbol, SecurityID, ContractMultiplier, UnderlyingSymbol, UnderlyingPx, TradeVolume24h, MarkPrice, OpenInterest, PutOrCall, CurrentFunding, Funding8h, NoMDEntries, MDEntriesGroup
+    > {
+        typedef Message<&M_MarketDataSnapshotFullRefresh, MDReqID, Symbol, SecurityID, ContractMultiplier, UnderlyingSymbol, UnderlyingPx, TradeVolume24h, MarkPrice, OpenInterest, PutOrCall, CurrentFunding, Funding8h, NoMDEntries, MDEntriesGroup> Base;
+        static constexpr const MsgTypeEnum Type = MsgTypeEnum::MarketDataSnapshotFullRefresh;
+        MarketDataSnapshotFullRefresh() : Base() {}
+        int parse(const char* src) { return Base::parse<MarketDataSnapshotFullRefresh>(src); }
+        static int parse_body(Base::Body& body, TvpParseData& pd) {
+            int bR = 0;
+            for (;;) {
+                switch (peek_tag(pd.buffer)) {
+                case 35: bR += body.field<Base::MsgType>().parse(pd); break;
+                case 49: bR += body.field<SenderCompID>().parse(pd); break;
+                case 56: bR += body.field<TargetCompID>().parse(pd); break;
+                case 34: bR += body.field<MsgSeqNum>().parse(pd); break;
+                case 43: bR += body.field<PossDupFlag>().parse(pd); break;
+                case 52: bR += body.field<SendingTime>().parse(pd); break;
+                case 97: bR += body.field<PossResend>().parse(pd); break;
+                case 262: bR += body.field<MDReqID>().parse(pd); break;
+                case 55: bR += body.field<Symbol>().parse(pd); break;
+                case 48: bR += body.field<SecurityID>().parse(pd); break;
+                case 231: bR += body.field<ContractMultiplier>().parse(pd); break;
+                case 311: bR += body.field<UnderlyingSymbol>().parse(pd); break;
+                case 810: bR += body.field<UnderlyingPx>().parse(pd); break;
+                case 100087: bR += body.field<TradeVolume24h>().parse(pd); break;
+                case 100090: bR += body.field<MarkPrice>().parse(pd); break;
+                case 746: bR += body.field<OpenInterest>().parse(pd); break;
+                case 201: bR += body.field<PutOrCall>().parse(pd); break;
+                case 100092: bR += body.field<CurrentFunding>().parse(pd); break;
+                case 100093: bR += body.field<Funding8h>().parse(pd); break;
+                case 268:
+                    bR += body.field<NoMDEntries>().parse(pd);
+                    pd.meta = body.field<NoMDEntries>().get();
+                    bR += body.field<MDEntriesGroup>().parse(pd);
+                    break;
+                case 10: case -1: return bR;
+                default: bR += skip_field(pd); break;
+                }
+            }
+        }
+    };
+
+    struct MarketDataIncrementalRefresh : public Message<
+        &M_MarketDataIncrementalRefresh, MDReqID, Symbol, ContractMultiplier, TradeVolume24h, MarkPrice, OpenInterest, PutOrCall, NoMDEntries, MarketDataIncrementalRefreshMDEntriesGroup
+    > {
+        typedef Message<&M_MarketDataIncrementalRefresh, MDReqID, Symbol, ContractMultiplier, TradeVolume24h, MarkPrice, OpenInterest, PutOrCall, NoMDEntries, MarketDataIncrementalRefreshMDEntriesGroup> Base;
+        static constexpr const MsgTypeEnum Type = MsgTypeEnum::MarketDataIncrementalRefresh;
+        MarketDataIncrementalRefresh() : Base() {}
+        int parse(const char* src) { return Base::parse<MarketDataIncrementalRefresh>(src); }
+        static int parse_body(Base::Body& body, TvpParseData& pd) {
+            int bR = 0;
+            for (;;) {
+                switch (peek_tag(pd.buffer)) {
+                case 35: bR += body.field<Base::MsgType>().parse(pd); break;
+                case 49: bR += body.field<SenderCompID>().parse(pd); break;
+                case 56: bR += body.field<TargetCompID>().parse(pd); break;
+                case 34: bR += body.field<MsgSeqNum>().parse(pd); break;
+                case 43: bR += body.field<PossDupFlag>().parse(pd); break;
+                case 52: bR += body.field<SendingTime>().parse(pd); break;
+                case 97: bR += body.field<PossResend>().parse(pd); break;
+                case 262: bR += body.field<MDReqID>().parse(pd); break;
+                case 55: bR += body.field<Symbol>().parse(pd); break;
+                case 231: bR += body.field<ContractMultiplier>().parse(pd); break;
+                case 100087: bR += body.field<TradeVolume24h>().parse(pd); break;
+                case 100090: bR += body.field<MarkPrice>().parse(pd); break;
+                case 746: bR += body.field<OpenInterest>().parse(pd); break;
+                case 201: bR += body.field<PutOrCall>().parse(pd); break;
+                case 268:
+                    bR += body.field<NoMDEntries>().parse(pd);
+                    pd.meta = body.field<NoMDEntries>().get();
+                    bR += body.field<MarketDataIncrementalRefreshMDEntriesGroup>().parse(pd);
+                    break;
+                case 10: case -1: return bR;
+                default: bR += skip_field(pd); break;
+                }
+            }
+        }
+    };
+
+}}
+
+#pragma GCC diagnostic pop
+
+#endif
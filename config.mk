@@ -0,0 +1,16 @@
+# Generated configuration file
+
+PROJECT_VERSION := 1.0.0
+PROJECT_BASE_DIR := /root/repo
+PROJECT_BUILD_DIR := /root/repo/build
+PROJECT_INCLUDE_DIR := /root/repo/include
+PROJECT_SRC_DIR := /root/repo/src
+INSTALL_DIR := /usr/local
+CXX := /usr/bin/g++
+VERBOSE := 0
+DEBUG := 0
+BUILD_DOCS := 0
+CXXFLAGS := -std=c++2a -O3 -DFIXATE_COMPACT_LAYOUT=1 -DFIXATE_TSC_CLOCK=0 -Wall -Werror=format -Wpedantic -Wno-switch -Wno-unused-function -Wno-deprecated-declarations
+INCS := -I/root/repo/include -I/usr/local/include
+LDFLAGS := -L/usr/local/lib -L./lib
+LIBS := -lssl -lcrypto
@@ -12,6 +12,8 @@ CXX=/usr/bin/g++
 VERBOSE=0
 DEBUG=0
 BUILD_DOCS=0
+COMPACT_LAYOUT=1
+TSC_CLOCK=0
 
 HELP_MESSAGE="Configuration Paramters:
 --cxx: Provide C++ compiler binary path.
@@ -19,6 +21,8 @@ HELP_MESSAGE="Configuration Paramters:
 --verbose: Enable compiler verbose mode. [0/1]
 --install_dir: Provide installation directory, default is '/usr/local'
 --build_docs: Build Doxygen documentation
+--compact_layout: Pack message fields into as few cache lines as possible. [0/1]
+--tsc_clock: Take timestamps from the calibrated TSC instead of CLOCK_REALTIME. [0/1]
 --help: Print this help message."
 
 for arg in "$@"; do
@@ -29,6 +33,8 @@ for arg in "$@"; do
         --verbose=*) VERBOSE="${arg#*=}"; ;;
         --install_dir=*) INSTALL_DIR="${arg#*=}"; ;;
         --build_docs=*) BUILD_DOCS="${arg#*=}"; ;;
+        --compact_layout=*) COMPACT_LAYOUT="${arg#*=}"; ;;
+        --tsc_clock=*) TSC_CLOCK="${arg#*=}"; ;;
         *) echo "Unknown option: $arg"; exit 1 ;;
     esac
 done
@@ -42,6 +48,8 @@ if [[ "${DEBUG}" == "1" ]]; then
 else
     CXXFLAGS="${CXXFLAGS} -O3"
 fi
+CXXFLAGS="${CXXFLAGS} -DFIXATE_COMPACT_LAYOUT=${COMPACT_LAYOUT}"
+CXXFLAGS="${CXXFLAGS} -DFIXATE_TSC_CLOCK=${TSC_CLOCK}"
 CXXFLAGS="${CXXFLAGS} -Wall -Werror=format -Wpedantic -Wno-switch -Wno-unused-function -Wno-deprecated-declarations"
 
 check_directories() {
@@ -109,7 +117,7 @@ check_libraries_exist() {
 
 INCLUDE_PATH="-I${PROJECT_BASE_DIR}/include -I/usr/local/include"
 LIBRARY_PATH="-L/usr/local/lib -L./lib"
-LIBRARIES="-lvrb -lssl -lcrypto"
+LIBRARIES="-lssl -lcrypto"
 
 echo "Checking Includes and Libraries:"
 check_directories "$INCLUDE_PATH"
@@ -142,6 +150,8 @@ echo "debug=${DEBUG}"
 echo "verbose=${VERBOSE}"
 echo "install_dir=${INSTALL_DIR}"
 echo "build_docs=${BUILD_DOCS}"
+echo "compact_layout=${COMPACT_LAYOUT}"
+echo "tsc_clock=${TSC_CLOCK}"
 echo
 echo "Build Parameters:"
 echo "CXXFLAGS=${CXXFLAGS}"
@@ -6,9 +6,8 @@
 #include <cstdint>
 #include <fstream>
 #include <cassert>
-#include <thread>
-#include <chrono>
 
+#include "fixate/fixbook.hpp"
 #include "deribitmsg.hpp"
 
 using namespace fixate;
@@ -30,26 +29,16 @@ public:
     typedef tcp_client DataSourceType;
     typedef FixEngine<tcp_client, DeribitMarketDataAdapter> FixEngineType;
     static constexpr const int HEARTBEAT_INTERVAL_SEC = 15;
+    static constexpr const int LOGON_TIMEOUT_SEC = 10;
 public:
     DeribitMarketDataAdapter(const DeribitConf& conf) : mConf(conf) {}
     ~DeribitMarketDataAdapter() { teardown(); }
     //! Call before program is about to die.
     void teardown() {
-        mTimerActive = false;
-        if (mTimerThread->joinable())
-            mTimerThread->join();
         mFixEngine.disconnect();
     }
     //! Establish connection to remote server and perform login. This is a blocking operation.
     bool connectAndLogOn() {
-        mTimerThread = std::make_unique<std::thread>([this](){
-            this->mTimerActive = true;
-            while (this->mTimerActive) {
-                this->mCurrentTimestamp = epoch_timestamp();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
-        });
-
         mDataSource = std::move(DataSourceType(mConf.remoteAddress, mConf.port,
                 [this](){ std::cout << "Connected " << this->mConf.remoteAddress << ":" << this->mConf.port << std::endl; },
                 [this](){ std::cout << "Disconnected " << this->mConf.remoteAddress << ":" << this->mConf.port << std::endl; },
@@ -58,23 +47,26 @@ public:
         mFixEngine.connect();
 
         int64_t ts = fx::epoch_timestamp();
-        LogonRequest logOnRequest(mConf.apiKey, mConf.secretKey, 15);
+        LogonRequest logOnRequest(mConf.apiKey, mConf.secretKey, HEARTBEAT_INTERVAL_SEC);
         logOnRequest.set<CancelOnDisconnect>('Y');
         logOnRequest.set<SenderCompId>(mConf.senderCompId);
         logOnRequest.set<TargetCompId>(mConf.targetCompId);
         int bytesSent = sendmsg(logOnRequest, ts);
         assert(((void)"Failed to send login message", (bytesSent > 0)));
-        while (!mIsLoggedOn && !mIsLogOnFailed) {
-            perform();
-        }
+        timer_wheel::id_type logOnTimeout = mFixEngine.timers().schedule_after(LOGON_TIMEOUT_SEC * 1000000000LL,
+                [this](int64_t) {
+                    std::cout << "Deribit: Logon timed out" << std::endl;
+                    mIsLogOnFailed = true;
+                });
+        while (!mIsLoggedOn && !mIsLogOnFailed && perform()) {}
+        mFixEngine.timers().cancel(logOnTimeout);
+        if (mIsLoggedOn) scheduleHeartbeat();
         return mIsLoggedOn;
     }
+    //! Process a message or wait for one, false once the session is gone.
     bool perform() {
-        if (mCurrentTimestamp > mNextHeartbeatTs && mIsLoggedOn) {
-            sendHeartbeat(mCurrentTimestamp);
-            mNextHeartbeatTs = mCurrentTimestamp + HEARTBEAT_INTERVAL_SEC * 1000000000LL;
-        }
-        return mFixEngine.perform();
+        mFixEngine.perform();
+        return mDataSource.active();
     }
     template <typename TFixMessage>
     size_t sendmsg(TFixMessage& msg, int64_t timestamp) {
@@ -82,11 +74,20 @@ public:
         msg.template set<fixate::SendingTime>(timestamp);
         return mFixEngine.sendmsg(msg);
     }
+    //! Send a TestRequest, the session is dropped unless its Heartbeat comes back within the interval.
     bool sendHeartbeat(int64_t ts) {
         TestRequest testRequest;
-        testRequest.set<fx::TestReqId>(std::to_string(ts));
+        mPendingTestReqId = std::to_string(ts);
+        testRequest.set<fx::TestReqId>(mPendingTestReqId);
         testRequest.set<fx::SenderCompId>(mConf.senderCompId);
         testRequest.set<fx::TargetCompId>(mConf.targetCompId);
+        mFixEngine.timers().cancel(mTestRequestTimeout);
+        mTestRequestTimeout = mFixEngine.timers().schedule_after(HEARTBEAT_INTERVAL_SEC * 1000000000LL,
+                [this](int64_t) {
+                    std::cout << "Deribit: No Heartbeat for TestRequest " << mPendingTestReqId << std::endl;
+                    mIsLoggedOn = false;
+                    mFixEngine.disconnect();
+                });
         return sendmsg(testRequest, ts) > 0;
     }
     bool subscribeMarketData(const std::string& contractName) {
@@ -112,14 +113,18 @@ public:
         if (msgType == MessageTypeEnum::MarketDataIncrementalRefresh) {
             MarketDataIncrementalRefresh m;
             m.parse(buffer);
+            if (mOrderBook.onIncremental<MDEntries>(m)) printTopOfBook();
         }
         else if (msgType == MessageTypeEnum::MarketDataSnapshotFullRefresh) {
             MarketDataSnapshotFullRefresh m;
             m.parse(buffer);
+            mOrderBook.onSnapshot<MDEntries>(m);
+            printTopOfBook();
         }
         else if (msgType == fx::MessageTypeEnum::Heartbeat) {
             Heartbeat m;
             m.parse(buffer);
+            if (m.get<fx::TestReqId>() == mPendingTestReqId) mFixEngine.timers().cancel(mTestRequestTimeout);
         }
         else if (msgType == fx::MessageTypeEnum::Logon)
         {
@@ -138,6 +143,19 @@ public:
             std::cout << "Deribit: LoggedOut, Reason: " << m.get<fx::Text>() << std::endl;
         }
     }
+    const OrderBook& orderBook() const { return mOrderBook; }
+private:
+    void scheduleHeartbeat() {
+        mFixEngine.timers().schedule_after(HEARTBEAT_INTERVAL_SEC * 1000000000LL, [this](int64_t now) {
+            if (!mIsLoggedOn) return;
+            sendHeartbeat(now);
+            scheduleHeartbeat();
+        });
+    }
+    void printTopOfBook() const {
+        std::cout << "Top of book: " << mOrderBook.bestBid().size << " @ " << mOrderBook.bestBid().price
+                  << " / " << mOrderBook.bestOffer().size << " @ " << mOrderBook.bestOffer().price << std::endl;
+    }
 private:
     DeribitConf mConf;
     DataSourceType mDataSource;
@@ -145,9 +163,8 @@ private:
     bool mIsLoggedOn = false;
     bool mIsLogOnFailed = false;
     int mOutMsgSeqNum = 0;
-    int64_t mNextHeartbeatTs = -1;
-    int64_t mCurrentTimestamp = -1;
-    bool mTimerActive = false;
-    std::unique_ptr<std::thread> mTimerThread;
+    std::string mPendingTestReqId;
+    timer_wheel::id_type mTestRequestTimeout = timer_wheel::npos;
+    OrderBook mOrderBook;
 };
 
@@ -18,12 +18,11 @@ int main(int argc, const char* argv[])
     mda.subscribeMarketData("BTC-PERPETUAL");
 
     try {
-        while (true) {
-            mda.perform();
-        }
+        while (mda.perform()) {}
     } catch (const connection_exception& exc) {
         std::cout << "Exception: " << exc.what() << std::endl;
     }
-    return 0;
+    std::cout << "Deribit: Session lost" << std::endl;
+    return 1;
 }
 
@@ -17,22 +17,33 @@
 #define FIXATE_CONNECTION_HPP_
 
 #include <ctime>
+#include <map>
+#include <array>
+#include <vector>
+#include <atomic>
 #include <string>
 #include <memory>
 #include <cstdlib>
 #include <functional>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/epoll.h>
+#include <sys/timerfd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <netdb.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
 #include <openssl/ssl.h>
-#include <ringbuffer/ringbuffer.h>
+#include "fixate/ringbuffer.hpp"
 
 namespace fixate {
 
@@ -48,6 +59,26 @@ namespace fixate {
         std::string msg;
     };
 
+    /**
+     * Timestamping source requested from the kernel for a socket. `software`
+     * stamps packets in the network stack, `hardware` asks the NIC for raw
+     * hardware stamps (the interface must have been configured for it, e.g.
+     * with `hwstamp_ctl`), and falls back to software stamps otherwise.
+     */
+    enum class timestamping : int { none = 0, software = 1, hardware = 2 };
+
+    /**
+     * Timestamps of a read or a write, in nanoseconds since epoch. `system`
+     * is taken by the application around the syscall, `software` and
+     * `hardware` are reported by the kernel and the NIC respectively and are
+     * zero when unavailable.
+     */
+    struct wire_timestamp {
+        int64_t system = 0;
+        int64_t software = 0;
+        int64_t hardware = 0;
+    };
+
     using on_connect = std::function<void()>;
     using on_disconnect = std::function<void()>;
     using on_error = std::function<void(int, const std::string&)>;
@@ -59,6 +90,8 @@ namespace fixate {
         static constexpr const int DEFAULT_ERROR_CODE = -1;
         static constexpr const int MAX_READ_SIZE = 8 * 1024;
         static constexpr const int MAX_EVENTS = 5;
+        static constexpr const int MAX_PENDING_READS = 256;
+        static constexpr const size_t DEFAULT_BUFFER_CAPACITY = 1 << 20;
         static int64_t system_timestamp();
     public:
         base_connection() {}
@@ -76,22 +109,66 @@ namespace fixate {
         int size();
         int poll();
         int send_message(const char *buffer, int size);
+        /**
+         * Send `count` buffers as one message, through a gather write where
+         * the transport has one. `iov` is advanced over partial writes.
+         */
+        int send_iov(iovec* iov, int count);
         bool active() const;
         int64_t last_sent_at() const;
         int64_t last_read_at() const;
+        void set_timestamping(timestamping mode);
+        void set_buffer_capacity(size_t capacity);
+        void set_memory_policy(const memory_policy& policy);
+        const wire_timestamp& last_rx_timestamp() const;
+        const wire_timestamp& last_tx_timestamp() const;
+        wire_timestamp read_timestamp(int size);
+        /**
+         * Wake `poll` at `deadline` (ns since epoch, 0 to disarm) through a
+         * timerfd in the connection's epoll set. Does nothing for connections
+         * without one or when spinning.
+         */
+        void arm_timer(int64_t deadline);
+        //! Poll without blocking, on a thread dedicated to the session.
+        void set_spin(bool spin) { poll_timeout = spin ? 0 : -1; }
     protected:
         bool has_data();
         int close_file_descriptor(int fd);
+        int enable_timestamping(int fd);
+        int receive(void* buffer, int size, sockaddr* src_addr = nullptr, socklen_t* addr_len = nullptr);
+        int read_error_queue();
+        void on_read(int size, const wire_timestamp& ts);
+        void prefault_buffer();
+        //! True, after draining it, if `event` is the timerfd's.
+        bool on_timer_event(const epoll_event& event);
+        //! Close the epoll set, the timerfd goes with it and is added again to the next one.
+        void close_epoll();
     protected:
+        struct pending_read { int64_t end; wire_timestamp ts; };
         epoll_event events[MAX_EVENTS];
         int sockfd = -1;
         int epollfd = -1;
+        int timerfd = -1;
+        //! Whether the timerfd is in the current epoll set.
+        bool timer_registered = false;
+        int64_t timer_deadline = 0;
+        int poll_timeout = -1;
         bool is_active = false;
         int port = 0;
         std::string remote_address;
         int64_t last_read_timestamp = 0;
         int64_t last_sent_timestamp = 0;
-        vrb_ctx_t* vrb_context = nullptr;
+        ring_buffer<> rx_buffer;
+        memory_policy buffer_policy;
+        timestamping timestamping_mode = timestamping::none;
+        wire_timestamp last_rx_ts;
+        wire_timestamp last_tx_ts;
+        //! Stamps of reads not yet fully consumed, indexed by stream offset.
+        std::array<pending_read, MAX_PENDING_READS> pending_reads;
+        uint64_t pending_first = 0;
+        uint64_t pending_last = 0;
+        int64_t bytes_received = 0;
+        int64_t bytes_consumed = 0;
         on_connect on_connect_cb;
         on_disconnect on_disconnect_cb;
         on_error on_error_cb;
@@ -100,7 +177,7 @@ namespace fixate {
     class tcp_client : public base_connection<tcp_client> {
     public:
         typedef base_connection<tcp_client> base;
-        using base::vrb_context;
+        using base::rx_buffer;
         using base::last_read_timestamp;
         using base::last_sent_timestamp;
     public:
@@ -116,15 +193,57 @@ namespace fixate {
         int disconnect();
         int poll();
         int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
     private:
         void error_handler();
         int open_connection(const char *hostname, const char *port);
     };
 
+    /**
+     * Acceptor side of a TCP session. `connect()` binds to the local address,
+     * listens (unless `listen()` was already called) and blocks until a single
+     * peer connects, or the accept timeout passes, after which the object
+     * behaves exactly like `tcp_client`.
+     * Polling never blocks, so the owner can interleave reads with its own
+     * publishing work.
+     */
+    class tcp_server : public base_connection<tcp_server> {
+    public:
+        typedef base_connection<tcp_server> base;
+        using base::rx_buffer;
+        using base::last_read_timestamp;
+        using base::last_sent_timestamp;
+        static constexpr const int LISTEN_BACKLOG = 1;
+    public:
+        tcp_server() : base() {}
+        tcp_server(const std::string& local_address, int port,
+                on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb);
+        tcp_server(const tcp_server& other) = delete;
+        tcp_server& operator=(const tcp_server& other) = delete;
+        tcp_server(tcp_server&& other);
+        tcp_server& operator=(tcp_server&& other);
+        ~tcp_server();
+        int listen();
+        int connect();
+        int disconnect();
+        int poll();
+        int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
+        //! Give up `connect` after `timeout_ms` without a peer, -1 waits forever.
+        void set_accept_timeout(int timeout_ms) { accept_timeout_ms = timeout_ms; }
+    private:
+        void error_handler();
+        int open_listener(const char *hostname, const char *port);
+        int accept_session();
+    private:
+        int listenfd = -1;
+        int accept_timeout_ms = -1;
+    };
+
     class tcp_ssl_client : public base_connection<tcp_ssl_client> {
     public:
         typedef base_connection<tcp_ssl_client> base;
-        using base::vrb_context;
+        using base::rx_buffer;
         using base::last_read_timestamp;
         using base::last_sent_timestamp;
     public:
@@ -140,6 +259,7 @@ namespace fixate {
         int disconnect();
         int poll();
         int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
     private:
         void error_handler(int ret_val);
         int open_connection(const char *hostname, const char *port);
@@ -151,7 +271,7 @@ namespace fixate {
     class udp_client : public base_connection<udp_client> {
     public:
         typedef base_connection<udp_client> base;
-        using base::vrb_context;
+        using base::rx_buffer;
         using base::last_read_timestamp;
         using base::last_sent_timestamp;
     public:
@@ -167,6 +287,7 @@ namespace fixate {
         int disconnect();
         int poll();
         int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
 
     private:
         void error_handler();
@@ -178,7 +299,7 @@ namespace fixate {
     class file_client : public base_connection<file_client> {
     public:
         typedef base_connection<file_client> base;
-        using base::vrb_context;
+        using base::rx_buffer;
         using base::last_read_timestamp;
         using base::last_sent_timestamp;
         enum class io_error : int
@@ -196,6 +317,7 @@ namespace fixate {
         int disconnect();
         int poll();
         int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
     private:
         void error_handler(io_error ec, const std::string& msg);
         FILE* fopen_or_die(const char *filename, const char *instruction);
@@ -206,6 +328,194 @@ namespace fixate {
         FILE* rfile = nullptr;
         FILE* wfile = nullptr;
     };
+
+    /**
+     * Identifies one direction of a TCP flow in a capture. An empty address or
+     * a zero port matches anything; the first flow matching the filter is
+     * locked on to and replayed.
+     */
+    struct flow_filter {
+        std::string src_address;
+        int src_port = 0;
+        std::string dst_address;
+        int dst_port = 0;
+    };
+
+    /**
+     * Replays the FIX byte stream of a TCP flow out of a pcap or pcapng
+     * capture. The file is memory mapped, payloads are reassembled in
+     * sequence order (retransmits are trimmed, out-of-order segments are
+     * held back until the gap is filled) and appended to the receive buffer.
+     * The capture timestamp of the segment completing a message is reported
+     * as its `hardware` stamp through `read_timestamp`.
+     */
+    class pcap_client : public base_connection<pcap_client> {
+    public:
+        typedef base_connection<pcap_client> base;
+        using base::rx_buffer;
+        using base::last_read_timestamp;
+        using base::last_sent_timestamp;
+        enum class io_error : int
+        { fsize = 1, fopen = 2, mmap = 3, format = 4, fread = 5, fwrite = 6 };
+        //! Out-of-order payload held back before a gap is declared lost.
+        static constexpr const size_t MAX_OUT_OF_ORDER_BYTES = 256 * 1024;
+        //! Largest IP packet, a segment is only taken when this much buffer is free.
+        static constexpr const int MAX_SEGMENT_SIZE = 64 * 1024;
+    public:
+        pcap_client() : base() {}
+        pcap_client(const std::string& filename, const flow_filter& filter,
+                on_connect on_connect_cb = nullptr, on_disconnect on_disconnect_cb = nullptr, on_error on_error_cb = nullptr);
+        pcap_client(const pcap_client& other) = delete;
+        pcap_client& operator=(const pcap_client& other) = delete;
+        pcap_client(pcap_client&& other);
+        pcap_client& operator=(pcap_client&& other);
+        ~pcap_client();
+        int connect();
+        int disconnect();
+        int poll();
+        int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
+        uint64_t retransmitted_bytes() const { return retransmitted; }
+        uint64_t lost_bytes() const { return lost; }
+    private:
+        struct capture_interface { int linktype; uint8_t tsresol; };
+        struct flow_address { int family = 0; uint8_t addr[16] = {}; };
+        void error_handler(io_error ec, const std::string& msg);
+        uint16_t read16(const uint8_t* p) const;
+        uint32_t read32(const uint8_t* p) const;
+        bool next_frame(const uint8_t*& frame, size_t& len, int& linktype, int64_t& ts);
+        void on_frame(const uint8_t* frame, size_t len, int linktype, const wire_timestamp& ts);
+        bool match(const flow_address& src, int sport, const flow_address& dst, int dport);
+        void on_segment(uint32_t seq, bool syn, const uint8_t* payload, size_t len, const wire_timestamp& ts);
+        void append(const uint8_t* payload, size_t len, const wire_timestamp& ts);
+        void drain(const wire_timestamp& ts);
+        void skip_gap(const wire_timestamp& ts);
+    private:
+        std::string filename;
+        flow_filter filter;
+        const uint8_t* map = nullptr;
+        size_t map_size = 0;
+        size_t offset = 0;
+        bool pcapng = false;
+        bool swapped = false;
+        std::vector<capture_interface> interfaces;
+        flow_address filter_src, filter_dst;
+        bool flow_locked = false;
+        flow_address flow_src, flow_dst;
+        int flow_sport = 0, flow_dport = 0;
+        bool synced = false;
+        uint32_t next_seq = 0;
+        std::map<uint32_t, std::string> out_of_order;
+        size_t out_of_order_bytes = 0;
+        int appended = 0;
+        int segments = 0;
+        uint64_t retransmitted = 0;
+        uint64_t lost = 0;
+        //! Capture time of the last frame read, stamps what the end of the capture releases.
+        int64_t frame_ts = 0;
+    };
+
+    /**
+     * Control block at the start of a shared memory ring. The data area that
+     * follows is mapped twice back to back, so that a message which wraps
+     * around the end of the ring is still contiguous in memory.
+     *
+     * `claim_cursor` is moved past a message before it is copied in and
+     * `write_cursor` after, so a reader which loads `claim_cursor` once it
+     * has parsed its bytes knows whether the publisher started overwriting
+     * them meanwhile, as with a seqlock.
+     */
+    struct shm_ring_header {
+        static constexpr const uint64_t MAGIC = 0x46495841544552ULL;
+        //! Stored last, with release ordering, once the rest is initialised.
+        std::atomic<uint64_t> magic;
+        uint64_t capacity;
+        alignas(64) std::atomic<uint64_t> write_cursor;
+        std::atomic<uint64_t> claim_cursor;
+    };
+
+    /**
+     * Writer side of a shared memory fan-out. A feed handler frames FIX
+     * messages with `send_message`, and any number of `shm_client` instances
+     * in other processes consume them. The publisher never waits for
+     * consumers, a consumer which falls more than `capacity` bytes behind is
+     * disconnected.
+     */
+    class shm_publisher : public base_connection<shm_publisher> {
+    public:
+        typedef base_connection<shm_publisher> base;
+        static constexpr const size_t HEADER_SIZE = 4096;
+        static constexpr const size_t DEFAULT_CAPACITY = 1 << 22;
+    public:
+        shm_publisher() : base() {}
+        shm_publisher(const std::string& name, size_t capacity,
+                on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb);
+        shm_publisher(const shm_publisher& other) = delete;
+        shm_publisher& operator=(const shm_publisher& other) = delete;
+        shm_publisher(shm_publisher&& other);
+        shm_publisher& operator=(shm_publisher&& other);
+        ~shm_publisher();
+        int connect();
+        int disconnect();
+        int poll();
+        int size();
+        int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
+    private:
+        void error_handler(int ec, const std::string& msg);
+    private:
+        std::string name;
+        size_t capacity = DEFAULT_CAPACITY;
+        shm_ring_header* header = nullptr;
+        char* data = nullptr;
+    };
+
+    /**
+     * Reader side of a shared memory fan-out. Every client keeps its own read
+     * cursor, messages are parsed in place from the shared mapping without
+     * being copied. A client joins the stream at the publisher's current
+     * position when it connects.
+     *
+     * The publisher may lap a slow client while a message is being parsed.
+     * `move_head` checks for it once the visitor returns, and disconnects
+     * with EOVERFLOW rather than carry on past a torn message. A visitor
+     * that must not act on a torn message checks `lapped()` before acting.
+     */
+    class shm_client : public base_connection<shm_client> {
+    public:
+        typedef base_connection<shm_client> base;
+        using base::last_read_timestamp;
+        using base::last_rx_ts;
+    public:
+        shm_client() : base() {}
+        shm_client(const std::string& name,
+                on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb);
+        shm_client(const shm_client& other) = delete;
+        shm_client& operator=(const shm_client& other) = delete;
+        shm_client(shm_client&& other);
+        shm_client& operator=(shm_client&& other);
+        ~shm_client();
+        int connect();
+        int disconnect();
+        const char* read_ptr();
+        int move_head(int size);
+        int size();
+        int poll();
+        int send_message(const char* buffer, int size);
+        int send_iov(iovec* iov, int count);
+        wire_timestamp read_timestamp(int size);
+        //! True if the publisher has started overwriting the bytes at `read_ptr()`.
+        bool lapped() const;
+    private:
+        void error_handler(int ec, const std::string& msg);
+    private:
+        std::string name;
+        size_t capacity = 0;
+        const shm_ring_header* header = nullptr;
+        const char* data = nullptr;
+        uint64_t read_cursor = 0;
+        uint64_t write_cursor = 0;
+    };
 }
 
 #include "connection_impl.hpp"
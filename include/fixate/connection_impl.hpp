@@ -24,13 +24,8 @@ namespace fixate
     template <typename ConnectionType>
     inline base_connection<ConnectionType>::base_connection(const std::string& remote_address, int port,
                 on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb)
-        : port(port), remote_address(remote_address), vrb_context(nullptr),
-                on_connect_cb(on_connect_cb), on_disconnect_cb(on_disconnect_cb), on_error_cb(on_error_cb)
-    {
-        size_t capacity = 1 << 20; // 1 MB of data can be buffered.
-        std::string name = std::string("shmqueue-") + char('0' + char(rand() % 10));
-        vrb_context = vrb_ctx_create(capacity, name.c_str());
-    }
+        : port(port), remote_address(remote_address), rx_buffer(DEFAULT_BUFFER_CAPACITY, "fixate-rx"),
+                on_connect_cb(on_connect_cb), on_disconnect_cb(on_disconnect_cb), on_error_cb(on_error_cb) {}
 
     template <typename ConnectionType>
     inline base_connection<ConnectionType>::base_connection(base_connection&& other)
@@ -49,20 +44,33 @@ namespace fixate
             on_connect_cb = std::move(other.on_connect_cb);
             on_disconnect_cb = std::move(other.on_disconnect_cb);
             on_error_cb = std::move(other.on_error_cb);
-            vrb_context = other.vrb_context;
-            other.vrb_context = nullptr;
+            rx_buffer = std::move(other.rx_buffer);
+            buffer_policy = other.buffer_policy;
+            timestamping_mode = other.timestamping_mode;
+            last_rx_ts = other.last_rx_ts;
+            last_tx_ts = other.last_tx_ts;
+            pending_reads = other.pending_reads;
+            pending_first = other.pending_first;
+            pending_last = other.pending_last;
+            bytes_received = other.bytes_received;
+            bytes_consumed = other.bytes_consumed;
+            if (timerfd != -1) close(timerfd);
+            timerfd = other.timerfd; other.timerfd = -1;
+            timer_registered = other.timer_registered; other.timer_registered = false;
+            timer_deadline = other.timer_deadline;
+            poll_timeout = other.poll_timeout;
         }
         return *this;
     }
 
     template <typename ConnectionType>
-    inline base_connection<ConnectionType>::~base_connection() { vrb_ctx_destroy(vrb_context); }
+    inline base_connection<ConnectionType>::~base_connection() {
+        if (timerfd != -1) close(timerfd);
+    }
 
     template <typename ConnectionType>
     inline int64_t base_connection<ConnectionType>::system_timestamp() {
-        timespec ts;
-        ::clock_gettime(CLOCK_REALTIME, &ts);
-        return (int64_t)ts.tv_sec * 1e+9 + ts.tv_nsec;
+        return ::fixate::system_timestamp();
     }
 
     template <typename ConnectionType>
@@ -83,17 +91,18 @@ namespace fixate
 
     template <typename ConnectionType>
     inline const char* base_connection<ConnectionType>::read_ptr() {
-        return reinterpret_cast<const char*>(vrb_prefetch_head(vrb_context));
+        return rx_buffer.prefetch_head();
     }
 
     template <typename ConnectionType>
     inline int base_connection<ConnectionType>::move_head(int size) {
-        return vrb_move_head(vrb_context, size);
+        bytes_consumed += size;
+        return rx_buffer.move_head(size);
     }
 
     template <typename ConnectionType>
     inline int base_connection<ConnectionType>::size() {
-        return vrb_size(vrb_context);
+        return rx_buffer.size();
     }
 
     template <typename ConnectionType>
@@ -106,6 +115,11 @@ namespace fixate
         return static_cast<ConnectionType*>(this)->send_message(buffer, size);
     }
 
+    template <typename ConnectionType>
+    inline int base_connection<ConnectionType>::send_iov(iovec* iov, int count) {
+        return static_cast<ConnectionType*>(this)->send_iov(iov, count);
+    }
+
     template <typename ConnectionType>
     inline bool base_connection<ConnectionType>::active() const { return is_active; }
 
@@ -115,6 +129,191 @@ namespace fixate
     template <typename ConnectionType>
     inline int64_t base_connection<ConnectionType>::last_read_at() const { return last_read_timestamp; }
 
+    template <typename ConnectionType>
+    inline void base_connection<ConnectionType>::set_timestamping(timestamping mode) { timestamping_mode = mode; }
+
+    template <typename ConnectionType>
+    inline void base_connection<ConnectionType>::arm_timer(int64_t deadline) {
+        if (epollfd == -1 || poll_timeout == 0) return;
+        if (deadline == timer_deadline && timer_registered) return;
+        if (timerfd == -1) {
+            timerfd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (timerfd < 0) throw connection_exception(errno, "timerfd_create failed");
+        }
+        if (!timer_registered) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = timerfd;
+            if (epoll_ctl(epollfd, EPOLL_CTL_ADD, timerfd, &event) != 0 && errno != EEXIST)
+                throw connection_exception(errno, "Failed to add timerfd to epoll set.");
+            timer_registered = true;
+        }
+        // A zero it_value disarms the timer.
+        itimerspec spec{};
+        spec.it_value.tv_sec = deadline / 1000000000LL;
+        spec.it_value.tv_nsec = deadline % 1000000000LL;
+        if (timerfd_settime(timerfd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0)
+            throw connection_exception(errno, "timerfd_settime failed");
+        timer_deadline = deadline;
+    }
+
+    template <typename ConnectionType>
+    inline bool base_connection<ConnectionType>::on_timer_event(const epoll_event& event) {
+        if (timerfd == -1 || event.data.fd != timerfd) return false;
+        uint64_t expirations;
+        while (read(timerfd, &expirations, sizeof(expirations)) > 0) {}
+        // Fired, the next arm_timer sets it again even for the same deadline.
+        timer_deadline = 0;
+        return true;
+    }
+
+    template <typename ConnectionType>
+    inline void base_connection<ConnectionType>::close_epoll() {
+        if (epollfd != -1) close(epollfd);
+        epollfd = -1;
+        timer_registered = false;
+    }
+
+    template <typename ConnectionType>
+    inline void base_connection<ConnectionType>::set_buffer_capacity(size_t capacity) {
+        if (rx_buffer.valid() && rx_buffer.size() > 0)
+            throw connection_exception(EBUSY, "Receive buffer can only be resized while empty.");
+        rx_buffer = ring_buffer<>(capacity, "fixate-rx", buffer_policy);
+    }
+
+    template <typename ConnectionType>
+    inline void base_connection<ConnectionType>::set_memory_policy(const memory_policy& policy) {
+        buffer_policy = policy;
+        // Pages are faulted in by connect, on the thread which will use them.
+        buffer_policy.prefault = false;
+        set_buffer_capacity(rx_buffer.valid() ? rx_buffer.capacity() : DEFAULT_BUFFER_CAPACITY);
+        buffer_policy.prefault = policy.prefault;
+    }
+
+    template <typename ConnectionType>
+    inline void base_connection<ConnectionType>::prefault_buffer() {
+        if (buffer_policy.prefault) rx_buffer.prefault();
+    }
+
+    template <typename ConnectionType>
+    inline const wire_timestamp& base_connection<ConnectionType>::last_rx_timestamp() const { return last_rx_ts; }
+
+    template <typename ConnectionType>
+    inline const wire_timestamp& base_connection<ConnectionType>::last_tx_timestamp() const { return last_tx_ts; }
+
+    template <typename ConnectionType>
+    inline wire_timestamp base_connection<ConnectionType>::read_timestamp(int size) {
+        // A message is stamped by the read which delivered its last byte.
+        int64_t end = bytes_consumed + size;
+        while (pending_first != pending_last) {
+            const pending_read& r = pending_reads[pending_first % MAX_PENDING_READS];
+            if (r.end >= end) return r.ts;
+            pending_first++;
+        }
+        return last_rx_ts;
+    }
+
+    template <typename ConnectionType>
+    inline void base_connection<ConnectionType>::on_read(int size, const wire_timestamp& ts) {
+        rx_buffer.move_tail(size);
+        bytes_received += size;
+        last_rx_ts = ts;
+        last_read_timestamp = ts.system;
+        // Drop the oldest stamp if the consumer is that far behind, its bytes
+        // are then attributed to the next read.
+        if (pending_last - pending_first == MAX_PENDING_READS) pending_first++;
+        pending_reads[pending_last++ % MAX_PENDING_READS] = pending_read{bytes_received, ts};
+    }
+
+    template <typename ConnectionType>
+    inline int base_connection<ConnectionType>::enable_timestamping(int fd) {
+        if (timestamping_mode == timestamping::none) return 0;
+        int flags = SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE
+            | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+        if (timestamping_mode == timestamping::hardware) {
+            flags |= SOF_TIMESTAMPING_RAW_HARDWARE | SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_TX_HARDWARE;
+        }
+        int ec = setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+        if (ec != 0) {
+            timestamping_mode = timestamping::none;
+            on_error_cb(errno, strerror(errno));
+        }
+        return ec;
+    }
+
+    namespace details {
+        inline int64_t timespec_to_ns(const timespec& ts) {
+            return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+        }
+        //! Step `msg` over `n` bytes already written, and any empty buffers.
+        inline void consume_iov(msghdr& msg, size_t n) {
+            while (msg.msg_iovlen > 0 && n >= msg.msg_iov->iov_len) {
+                n -= msg.msg_iov->iov_len;
+                msg.msg_iov++;
+                msg.msg_iovlen--;
+            }
+            if (msg.msg_iovlen > 0) {
+                msg.msg_iov->iov_base = static_cast<char*>(msg.msg_iov->iov_base) + n;
+                msg.msg_iov->iov_len -= n;
+            }
+        }
+        inline void read_scm_timestamping(msghdr* msg, wire_timestamp& ts) {
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPING) {
+                    const scm_timestamping* stamps = reinterpret_cast<const scm_timestamping*>(CMSG_DATA(cmsg));
+                    ts.software = timespec_to_ns(stamps->ts[0]);
+                    ts.hardware = timespec_to_ns(stamps->ts[2]);
+                }
+            }
+        }
+    }
+
+    template <typename ConnectionType>
+    inline int base_connection<ConnectionType>::receive(void* buffer, int size, sockaddr* src_addr, socklen_t* addr_len) {
+        wire_timestamp ts;
+        int bytes_read = 0;
+        if (timestamping_mode == timestamping::none) {
+            bytes_read = recvfrom(sockfd, buffer, size, 0, src_addr, addr_len);
+        } else {
+            alignas(cmsghdr) char control[256];
+            iovec iov{buffer, size_t(size)};
+            msghdr msg{};
+            msg.msg_name = src_addr;
+            msg.msg_namelen = addr_len ? *addr_len : 0;
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            bytes_read = recvmsg(sockfd, &msg, 0);
+            if (bytes_read > 0) details::read_scm_timestamping(&msg, ts);
+            if (addr_len) *addr_len = msg.msg_namelen;
+        }
+        if (bytes_read > 0) {
+            ts.system = system_timestamp();
+            on_read(bytes_read, ts);
+        }
+        return bytes_read;
+    }
+
+    template <typename ConnectionType>
+    inline int base_connection<ConnectionType>::read_error_queue() {
+        if (timestamping_mode == timestamping::none) return 0;
+        int count = 0;
+        while (true) {
+            alignas(cmsghdr) char control[256];
+            msghdr msg{};
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            if (recvmsg(sockfd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) break;
+            wire_timestamp ts;
+            details::read_scm_timestamping(&msg, ts);
+            ts.system = last_sent_timestamp;
+            last_tx_ts = ts;
+            count++;
+        }
+        return count;
+    }
+
     template <typename ConnectionType>
     inline bool base_connection<ConnectionType>::has_data() {
         // check if there is data to read
@@ -138,16 +337,24 @@ namespace fixate
         : base(remote_address, port, on_connect_cb, on_disconnect_cb, on_error_cb) {}
 
     inline tcp_client::tcp_client(tcp_client&& other)
-        : base(static_cast<base&&>(other)) {}
+        : base(static_cast<base&&>(other))
+    {
+        epollfd = other.epollfd; other.epollfd = -1;
+    }
 
     inline tcp_client& tcp_client::operator=(tcp_client&& other) {
         if (this != &other) {
             base::operator=(std::move(static_cast<base&&>(other)));
+            this->close_epoll();
+            epollfd = other.epollfd; other.epollfd = -1;
         }
         return *this;
     }
 
-    inline tcp_client::~tcp_client() { disconnect(); }
+    inline tcp_client::~tcp_client() {
+        disconnect();
+        this->close_epoll();
+    }
 
     inline void tcp_client::error_handler() {
         int ec = errno;
@@ -159,9 +366,11 @@ namespace fixate
 
     inline int tcp_client::connect()
     {
+        this->prefault_buffer();
         std::string port_str = std::to_string(this->port);
         this->sockfd = open_connection(this->remote_address.c_str(), port_str.c_str());
         if (this->sockfd != -1) {
+            this->enable_timestamping(this->sockfd);
             this->is_active = true;
             on_connect_cb();
         }
@@ -179,21 +388,26 @@ namespace fixate
 
     inline int tcp_client::poll()
     {
-        int nfds = epoll_wait(this->epollfd, this->events, this->MAX_EVENTS, -1);
+        int nfds = epoll_wait(this->epollfd, this->events, this->MAX_EVENTS, this->poll_timeout);
         for (int i = 0; i < nfds; ++i) {
+            if (this->on_timer_event(this->events[i])) continue;
             if (this->events[i].events & EPOLLIN) {
-                void* buffer = reinterpret_cast<void*>(vrb_prefetch_tail(vrb_context));
+                void* buffer = reinterpret_cast<void*>(rx_buffer.prefetch_tail());
                 int size = this->MAX_READ_SIZE;
-                int bytes_read = recv(this->sockfd, buffer, size, 0);
-                if (bytes_read > 0) {
-                    vrb_move_tail(vrb_context, bytes_read);
-                    last_read_timestamp = system_timestamp();
-                } else if (bytes_read < 0) { error_handler(); }
+                int bytes_read = this->receive(buffer, size);
+                if (bytes_read < 0) { error_handler(); }
+                else if (bytes_read == 0) { disconnect(); return nfds; }
+            }
+            // Transmit timestamps are delivered through the error queue.
+            if ((this->events[i].events & EPOLLERR) && !(this->events[i].events & EPOLLHUP)
+                    && this->read_error_queue() > 0) {
+                continue;
             }
             if (this->events[i].events & (EPOLLERR | EPOLLHUP)) {
-                close(this->sockfd);
-                close(this->epollfd);
                 error_handler();
+                disconnect();
+                this->close_epoll();
+                return nfds;
             }
         }
         return nfds;
@@ -214,6 +428,24 @@ namespace fixate
         return bytes_written;
     }
 
+    inline int tcp_client::send_iov(iovec* iov, int count)
+    {
+        int64_t now = system_timestamp();
+        int bytes_written = 0;
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        details::consume_iov(msg, 0);
+        while (msg.msg_iovlen > 0 && this->is_active) {
+            int bytes_sent = sendmsg(this->sockfd, &msg, MSG_NOSIGNAL);
+            if (bytes_sent > 0) { bytes_written += bytes_sent; details::consume_iov(msg, bytes_sent); }
+            else if (bytes_sent < 0 && errno != EAGAIN) { error_handler(); disconnect(); }
+            else if (bytes_sent == 0) { disconnect(); }
+        }
+        last_sent_timestamp = now;
+        return bytes_written;
+    }
+
     inline int tcp_client::open_connection(const char *hostname, const char *port)
     {
         struct addrinfo hints;
@@ -235,11 +467,14 @@ namespace fixate
             // Set non-blocking socket.
             int flags = fcntl(sfd, F_GETFL, 0);
             fcntl(sfd, F_SETFL, flags | O_NONBLOCK);
+            // Disable Nagle's algorithm, every FIX message is flushed as it is sent.
+            int nodelay = 1;
+            setsockopt(sfd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
 
             // Create epoll instance
+            this->close_epoll();
             epollfd = epoll_create1(0);
             if (epollfd < 0) {
-                close(epollfd);
                 on_error_cb(errno, strerror(errno));
                 throw connection_exception(errno, "epoll_create1 failed");
             }
@@ -269,6 +504,206 @@ namespace fixate
 }
 
 
+namespace fixate
+{
+    inline tcp_server::tcp_server(const std::string& local_address, int port,
+                on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb)
+        : base(local_address, port, on_connect_cb, on_disconnect_cb, on_error_cb) {}
+
+    inline tcp_server::tcp_server(tcp_server&& other)
+        : base(static_cast<base&&>(other))
+    {
+        epollfd = other.epollfd; other.epollfd = -1;
+        listenfd = other.listenfd; other.listenfd = -1;
+        accept_timeout_ms = other.accept_timeout_ms;
+    }
+
+    inline tcp_server& tcp_server::operator=(tcp_server&& other) {
+        if (this != &other) {
+            base::operator=(std::move(static_cast<base&&>(other)));
+            this->close_epoll();
+            epollfd = other.epollfd; other.epollfd = -1;
+            listenfd = other.listenfd; other.listenfd = -1;
+            accept_timeout_ms = other.accept_timeout_ms;
+        }
+        return *this;
+    }
+
+    inline tcp_server::~tcp_server() {
+        disconnect();
+        if (listenfd != -1) close(listenfd);
+        this->close_epoll();
+    }
+
+    inline void tcp_server::error_handler() {
+        int ec = errno;
+        switch (ec) {
+            case EAGAIN: break;
+            default: on_error_cb(ec, strerror(ec)); break;
+        }
+    }
+
+    inline int tcp_server::listen()
+    {
+        if (listenfd == -1) {
+            std::string port_str = std::to_string(this->port);
+            listenfd = open_listener(this->remote_address.c_str(), port_str.c_str());
+        }
+        return listenfd;
+    }
+
+    inline int tcp_server::connect()
+    {
+        this->prefault_buffer();
+        listen();
+        this->sockfd = accept_session();
+        if (this->sockfd != -1) {
+            this->enable_timestamping(this->sockfd);
+            this->is_active = true;
+            if (on_connect_cb) on_connect_cb();
+        }
+        return this->sockfd;
+    }
+
+    inline int tcp_server::disconnect()
+    {
+        if (!this->is_active) return !this->is_active;
+        if (on_disconnect_cb) on_disconnect_cb();
+        epoll_ctl(this->epollfd, EPOLL_CTL_DEL, this->sockfd, nullptr);
+        int ec = close_file_descriptor(this->sockfd);
+        this->sockfd = -1;
+        this->is_active = false;
+        return ec;
+    }
+
+    inline int tcp_server::poll()
+    {
+        if (!this->is_active) return 0;
+        int nfds = epoll_wait(this->epollfd, this->events, this->MAX_EVENTS, 0);
+        for (int i = 0; i < nfds; ++i) {
+            if (this->on_timer_event(this->events[i])) continue;
+            if (this->events[i].events & EPOLLIN) {
+                void* buffer = reinterpret_cast<void*>(rx_buffer.prefetch_tail());
+                int size = this->MAX_READ_SIZE;
+                int bytes_read = this->receive(buffer, size);
+                if (bytes_read < 0) { error_handler(); }
+                else if (bytes_read == 0) { disconnect(); return nfds; }
+            }
+            if ((this->events[i].events & EPOLLERR) && !(this->events[i].events & EPOLLHUP)
+                    && this->read_error_queue() > 0) {
+                continue;
+            }
+            if (this->events[i].events & (EPOLLERR | EPOLLHUP)) {
+                error_handler();
+                disconnect();
+                return nfds;
+            }
+        }
+        return nfds;
+    }
+
+    inline int tcp_server::send_message(const char *buffer, int size)
+    {
+        int64_t now = system_timestamp();
+        int bytes_written = 0;
+        while (bytes_written < size && this->is_active) {
+            const void* ptr = (const void*)(buffer + bytes_written);
+            int bytes_sent = send(this->sockfd, ptr, size - bytes_written, MSG_NOSIGNAL);
+            if (bytes_sent > 0) { bytes_written += bytes_sent; }
+            else if (bytes_sent < 0 && errno != EAGAIN) { error_handler(); disconnect(); }
+        }
+        last_sent_timestamp = now;
+        return bytes_written;
+    }
+
+    inline int tcp_server::send_iov(iovec* iov, int count)
+    {
+        int64_t now = system_timestamp();
+        int bytes_written = 0;
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        details::consume_iov(msg, 0);
+        while (msg.msg_iovlen > 0 && this->is_active) {
+            int bytes_sent = sendmsg(this->sockfd, &msg, MSG_NOSIGNAL);
+            if (bytes_sent > 0) { bytes_written += bytes_sent; details::consume_iov(msg, bytes_sent); }
+            else if (bytes_sent < 0 && errno != EAGAIN) { error_handler(); disconnect(); }
+        }
+        last_sent_timestamp = now;
+        return bytes_written;
+    }
+
+    inline int tcp_server::open_listener(const char *hostname, const char *port)
+    {
+        struct addrinfo hints;
+        std::memset(&hints, 0, sizeof(struct addrinfo));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        hints.ai_flags = AI_PASSIVE;
+
+        struct addrinfo *addrs = nullptr;
+        const char* node = (hostname == nullptr || hostname[0] == '\0') ? nullptr : hostname;
+        int status = getaddrinfo(node, port, &hints, &addrs);
+        if (status != 0) {
+            on_error_cb(errno, strerror(errno));
+            throw connection_exception(errno, std::string(hostname) + ": " + gai_strerror(status));
+        }
+        int lfd = -1, err = 0;
+        for (struct addrinfo *addr = addrs; addr != nullptr; addr = addr->ai_next) {
+            lfd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+            if (lfd == this->DEFAULT_ERROR_CODE) { err = errno; continue; }
+            int reuse = 1;
+            setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            if (bind(lfd, addr->ai_addr, addr->ai_addrlen) == 0 && ::listen(lfd, LISTEN_BACKLOG) == 0) break;
+            err = errno;
+            close_file_descriptor(lfd);
+            lfd = this->DEFAULT_ERROR_CODE;
+        }
+        freeaddrinfo(addrs);
+        if (lfd == this->DEFAULT_ERROR_CODE) {
+            on_error_cb(err, strerror(err));
+            throw connection_exception(err, "Failed to listen on " + std::string(hostname) + ":" + std::string(port));
+        }
+        return lfd;
+    }
+
+    inline int tcp_server::accept_session()
+    {
+        pollfd pending{listenfd, POLLIN, 0};
+        int ready = ::poll(&pending, 1, accept_timeout_ms);
+        if (ready <= 0) {
+            int ec = ready == 0 ? ETIMEDOUT : errno;
+            on_error_cb(ec, strerror(ec));
+            return this->DEFAULT_ERROR_CODE;
+        }
+        int sfd = accept(listenfd, nullptr, nullptr);
+        if (sfd == this->DEFAULT_ERROR_CODE) {
+            on_error_cb(errno, strerror(errno));
+            return sfd;
+        }
+        // Set non-blocking socket.
+        int flags = fcntl(sfd, F_GETFL, 0);
+        fcntl(sfd, F_SETFL, flags | O_NONBLOCK);
+        int nodelay = 1;
+        setsockopt(sfd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        if (epollfd == -1) {
+            epollfd = epoll_create1(0);
+            if (epollfd < 0) {
+                on_error_cb(errno, strerror(errno));
+                throw connection_exception(errno, "epoll_create1 failed");
+            }
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLERR | EPOLLHUP;
+        event.data.fd = sfd;
+        epoll_ctl(epollfd, EPOLL_CTL_ADD, sfd, &event);
+        return sfd;
+    }
+
+}
+
 namespace fixate {
 
     namespace details {
@@ -343,6 +778,7 @@ namespace fixate {
 
     inline int tcp_ssl_client::connect()
     {
+        this->prefault_buffer();
         std::string port_str = std::to_string(this->port);
         this->sockfd = open_connection(this->remote_address.c_str(), port_str.c_str());
         if (this->sockfd != -1) {
@@ -367,12 +803,13 @@ namespace fixate {
         if (!this->is_active)
             return 0;
 
-        void* buffer = reinterpret_cast<void*>(vrb_prefetch_tail(vrb_context));
+        void* buffer = reinterpret_cast<void*>(rx_buffer.prefetch_tail());
         int size = this->MAX_READ_SIZE;
         int bytes_read = SSL_read(ssl, buffer, size);
         if (bytes_read > 0) {
-            vrb_move_tail(vrb_context, bytes_read);
-            last_read_timestamp = system_timestamp();
+            wire_timestamp ts;
+            ts.system = system_timestamp();
+            this->on_read(bytes_read, ts);
         }
         else if (bytes_read < 0) { error_handler(bytes_read); }
         else { disconnect(); }
@@ -394,6 +831,16 @@ namespace fixate {
         return bytes_written;
     }
 
+    //! TLS has no gather write, every buffer goes out as a record of its own.
+    inline int tcp_ssl_client::send_iov(iovec* iov, int count)
+    {
+        int bytes_written = 0;
+        for (int i = 0; i < count; ++i) {
+            if (iov[i].iov_len > 0) bytes_written += send_message(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+        }
+        return bytes_written;
+    }
+
     inline int tcp_ssl_client::open_connection(const char *hostname, const char *port)
     {
         struct addrinfo hints;
@@ -504,9 +951,11 @@ namespace fixate {
 
     inline int udp_client::connect()
     {
+        this->prefault_buffer();
         std::string port_str = std::to_string(this->port);
         this->sockfd = open_connection(this->remote_address.c_str(), port_str.c_str());
         if (this->sockfd != -1) {
+            this->enable_timestamping(this->sockfd);
             this->is_active = true;
             on_connect_cb();
         }
@@ -524,17 +973,14 @@ namespace fixate {
 
     inline int udp_client::poll()
     {
-        void* buffer = reinterpret_cast<void*>(vrb_prefetch_tail(vrb_context));
+        this->read_error_queue();
+        void* buffer = reinterpret_cast<void*>(rx_buffer.prefetch_tail());
         int size = this->MAX_READ_SIZE;
         struct sockaddr_in sender_addr;
         socklen_t addr_size = sizeof(server_addr);
-        int bytes_read = recvfrom(this->sockfd, buffer, size, 0, (struct sockaddr*)&sender_addr, &addr_size);
-        if (bytes_read > 0) {
-            vrb_move_tail(vrb_context, bytes_read);
-            last_read_timestamp = system_timestamp();
-        }
-        else if (bytes_read < 0) { error_handler(); }
-        else { disconnect(); }
+        int bytes_read = this->receive(buffer, size, (struct sockaddr*)&sender_addr, &addr_size);
+        if (bytes_read < 0) { error_handler(); }
+        else if (bytes_read == 0) { disconnect(); }
         return bytes_read;
     }
 
@@ -553,6 +999,27 @@ namespace fixate {
         return bytes_written;
     }
 
+    //! The whole message goes out as one datagram.
+    inline int udp_client::send_iov(iovec* iov, int count)
+    {
+        int64_t now = system_timestamp();
+        int bytes_written = 0;
+        msghdr msg{};
+        msg.msg_name = &server_addr;
+        msg.msg_namelen = sizeof(server_addr);
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        details::consume_iov(msg, 0);
+        while (msg.msg_iovlen > 0 && this->is_active) {
+            int bytes_sent = sendmsg(this->sockfd, &msg, 0);
+            if (bytes_sent > 0) { bytes_written += bytes_sent; details::consume_iov(msg, bytes_sent); }
+            else if (bytes_sent < 0 && errno != EAGAIN) { error_handler(); disconnect(); }
+            else if (bytes_sent == 0) { disconnect(); }
+        }
+        last_sent_timestamp = now;
+        return bytes_written;
+    }
+
     inline int udp_client::open_connection(const char *hostname, const char *port)
     {
         struct addrinfo hints;
@@ -645,6 +1112,7 @@ namespace fixate {
 
     inline int file_client::connect()
     {
+        this->prefault_buffer();
         std::string wfilename = filename + "_output";
         rfile = fopen_or_die(filename.c_str(), "rb");
         wfile = fopen_or_die(wfilename.c_str(), "wb");
@@ -669,12 +1137,13 @@ namespace fixate {
     {
         if (!this->is_active) return 0;
 
-        void* buffer = reinterpret_cast<void*>(vrb_prefetch_tail(vrb_context));
+        void* buffer = reinterpret_cast<void*>(rx_buffer.prefetch_tail());
         int size = this->MAX_READ_SIZE;
         int bytes_read = fread(buffer, 1, size, rfile);
         if (bytes_read > 0) {
-            vrb_move_tail(vrb_context, bytes_read);
-            last_read_timestamp = system_timestamp();
+            wire_timestamp ts;
+            ts.system = system_timestamp();
+            this->on_read(bytes_read, ts);
         }
         else if (feof(rfile)) {
             last_read_timestamp = system_timestamp();
@@ -699,6 +1168,698 @@ namespace fixate {
         return bytes_written;
     }
 
+    //! Gathered by the stream's own buffer.
+    inline int file_client::send_iov(iovec* iov, int count)
+    {
+        int bytes_written = 0;
+        for (int i = 0; i < count; ++i) {
+            if (iov[i].iov_len > 0) bytes_written += send_message(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+        }
+        return bytes_written;
+    }
+
 }
-#endif
 
+namespace fixate {
+
+    namespace details {
+
+        inline uint16_t load_be16(const uint8_t* p) { return uint16_t(p[0] << 8 | p[1]); }
+
+        inline uint32_t load_be32(const uint8_t* p) {
+            return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | uint32_t(p[3]);
+        }
+
+        /**
+         * Convert a capture timestamp in units of `tsresol` (pcapng if_tsresol
+         * encoding, negative power of 10, or of 2 when the MSB is set) to ns.
+         */
+        inline int64_t capture_to_ns(uint64_t t, uint8_t tsresol)
+        {
+            if (tsresol & 0x80) {
+                int shift = tsresol & 0x7f;
+                if (shift >= 64) return 0;
+                uint64_t mask = (uint64_t(1) << shift) - 1;
+                return int64_t((t >> shift) * 1000000000ull + (((t & mask) * 1000000000ull) >> shift));
+            }
+            uint64_t scale = 1;
+            for (int i = tsresol; i < 9; ++i) scale *= 10;
+            for (int i = 9; i < tsresol; ++i) t /= 10;
+            return int64_t(t * scale);
+        }
+    }
+
+    inline pcap_client::pcap_client(const std::string& filename, const flow_filter& filter,
+                on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb)
+        : base("", 0, on_connect_cb, on_disconnect_cb, on_error_cb), filename(filename), filter(filter) {}
+
+    inline pcap_client::pcap_client(pcap_client&& other)
+        : base(static_cast<base&&>(other))
+    {
+        filename = std::move(other.filename);
+        filter = std::move(other.filter);
+        map = other.map; other.map = nullptr;
+        map_size = other.map_size; other.map_size = 0;
+        offset = other.offset;
+        pcapng = other.pcapng;
+        swapped = other.swapped;
+        interfaces = std::move(other.interfaces);
+        filter_src = other.filter_src;
+        filter_dst = other.filter_dst;
+        flow_locked = other.flow_locked;
+        flow_src = other.flow_src;
+        flow_dst = other.flow_dst;
+        flow_sport = other.flow_sport;
+        flow_dport = other.flow_dport;
+        synced = other.synced;
+        next_seq = other.next_seq;
+        out_of_order = std::move(other.out_of_order);
+        out_of_order_bytes = other.out_of_order_bytes;
+        retransmitted = other.retransmitted;
+        lost = other.lost;
+        frame_ts = other.frame_ts;
+    }
+
+    inline pcap_client& pcap_client::operator=(pcap_client&& other) {
+        if (this != &other) {
+            base::operator=(std::move(static_cast<base&&>(other)));
+            filename = std::move(other.filename);
+            filter = std::move(other.filter);
+            map = other.map; other.map = nullptr;
+            map_size = other.map_size; other.map_size = 0;
+            offset = other.offset;
+            pcapng = other.pcapng;
+            swapped = other.swapped;
+            interfaces = std::move(other.interfaces);
+            filter_src = other.filter_src;
+            filter_dst = other.filter_dst;
+            flow_locked = other.flow_locked;
+            flow_src = other.flow_src;
+            flow_dst = other.flow_dst;
+            flow_sport = other.flow_sport;
+            flow_dport = other.flow_dport;
+            synced = other.synced;
+            next_seq = other.next_seq;
+            out_of_order = std::move(other.out_of_order);
+            out_of_order_bytes = other.out_of_order_bytes;
+            retransmitted = other.retransmitted;
+            lost = other.lost;
+            frame_ts = other.frame_ts;
+        }
+        return *this;
+    }
+
+    inline pcap_client::~pcap_client() { disconnect(); }
+
+    inline void pcap_client::error_handler(io_error ec, const std::string& msg) {
+        throw connection_exception(static_cast<int>(ec), msg);
+    }
+
+    inline uint16_t pcap_client::read16(const uint8_t* p) const {
+        uint16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return swapped ? __builtin_bswap16(v) : v;
+    }
+
+    inline uint32_t pcap_client::read32(const uint8_t* p) const {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return swapped ? __builtin_bswap32(v) : v;
+    }
+
+    inline int pcap_client::connect()
+    {
+        this->prefault_buffer();
+        auto parse_address = [this](const std::string& address, flow_address& out) {
+            out = flow_address();
+            if (address.empty()) return;
+            if (inet_pton(AF_INET, address.c_str(), out.addr) == 1) out.family = AF_INET;
+            else if (inet_pton(AF_INET6, address.c_str(), out.addr) == 1) out.family = AF_INET6;
+            else error_handler(io_error::format, "Invalid flow address: \"" + address + "\"");
+        };
+        parse_address(filter.src_address, filter_src);
+        parse_address(filter.dst_address, filter_dst);
+
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) error_handler(io_error::fopen, "Failed to open file: \"" + filename + "\"");
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < 24) {
+            close(fd);
+            error_handler(io_error::fsize, "File \"" + filename + "\" is not a capture.");
+        }
+        map_size = st.st_size;
+        void* addr = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) error_handler(io_error::mmap, "Failed to map file: \"" + filename + "\"");
+        madvise(addr, map_size, MADV_SEQUENTIAL);
+        map = static_cast<const uint8_t*>(addr);
+
+        uint32_t magic;
+        std::memcpy(&magic, map, sizeof(magic));
+        interfaces.clear();
+        if (magic == 0xa1b2c3d4 || magic == 0xd4c3b2a1 || magic == 0xa1b23c4d || magic == 0x4d3cb2a1) {
+            pcapng = false;
+            swapped = magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1;
+            uint8_t tsresol = (magic == 0xa1b2c3d4 || magic == 0xd4c3b2a1) ? 6 : 9;
+            interfaces.push_back(capture_interface{int(read32(map + 20) & 0x0fffffff), tsresol});
+            offset = 24;
+        }
+        else if (magic == 0x0a0d0d0a) {
+            pcapng = true;
+            offset = 0;
+        }
+        else {
+            munmap(const_cast<uint8_t*>(map), map_size);
+            map = nullptr;
+            error_handler(io_error::format, "Unknown capture format: \"" + filename + "\"");
+        }
+        flow_locked = synced = false;
+        out_of_order.clear();
+        out_of_order_bytes = 0;
+        retransmitted = lost = 0;
+        frame_ts = 0;
+        this->is_active = true;
+        if (on_connect_cb) on_connect_cb();
+        return 1;
+    }
+
+    inline int pcap_client::disconnect()
+    {
+        if (!this->is_active) return !this->is_active;
+        if (on_disconnect_cb) on_disconnect_cb();
+        munmap(const_cast<uint8_t*>(map), map_size);
+        map = nullptr;
+        this->is_active = false;
+        return 1;
+    }
+
+    inline bool pcap_client::next_frame(const uint8_t*& frame, size_t& len, int& linktype, int64_t& ts)
+    {
+        if (!pcapng) {
+            if (offset + 16 > map_size) return false;
+            const uint8_t* rec = map + offset;
+            uint32_t caplen = read32(rec + 8);
+            if (offset + 16 + caplen > map_size) return false;
+            const capture_interface& iface = interfaces.front();
+            ts = details::capture_to_ns(uint64_t(read32(rec)) * (iface.tsresol == 6 ? 1000000 : 1000000000)
+                    + read32(rec + 4), iface.tsresol);
+            frame = rec + 16;
+            len = caplen;
+            linktype = iface.linktype;
+            offset += 16 + caplen;
+            return true;
+        }
+        while (offset + 12 <= map_size) {
+            const uint8_t* block = map + offset;
+            if (std::memcmp(block, "\x0a\x0d\x0d\x0a", 4) == 0) {
+                uint32_t bom;
+                std::memcpy(&bom, block + 8, sizeof(bom));
+                if (bom != 0x1a2b3c4d && bom != 0x4d3c2b1a) return false;
+                swapped = bom == 0x4d3c2b1a;
+                interfaces.clear();
+            }
+            uint32_t type = read32(block);
+            uint32_t total = read32(block + 4);
+            if (total < 12 || (total & 3) != 0 || offset + total > map_size) return false;
+            offset += total;
+            const uint8_t* body = block + 8;
+            size_t body_len = total - 12;
+            if (type == 1 && body_len >= 8) {
+                capture_interface iface{read16(body), 6};
+                for (size_t pos = 8; pos + 4 <= body_len; ) {
+                    uint16_t code = read16(body + pos), opt_len = read16(body + pos + 2);
+                    if (code == 0) break;
+                    if (code == 9 && opt_len >= 1 && pos + 5 <= body_len) iface.tsresol = body[pos + 4];
+                    pos += 4 + ((opt_len + 3u) & ~3u);
+                }
+                interfaces.push_back(iface);
+            }
+            else if (type == 6 && body_len >= 20) {
+                uint32_t id = read32(body), caplen = read32(body + 12);
+                if (id >= interfaces.size() || 20 + size_t(caplen) > body_len) continue;
+                uint64_t t = uint64_t(read32(body + 4)) << 32 | read32(body + 8);
+                ts = details::capture_to_ns(t, interfaces[id].tsresol);
+                frame = body + 20;
+                len = caplen;
+                linktype = interfaces[id].linktype;
+                return true;
+            }
+            else if (type == 3 && body_len >= 4 && !interfaces.empty()) {
+                // Simple packet blocks carry no timestamp.
+                ts = 0;
+                frame = body + 4;
+                len = std::min<size_t>(read32(body), body_len - 4);
+                linktype = interfaces.front().linktype;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline bool pcap_client::match(const flow_address& src, int sport, const flow_address& dst, int dport)
+    {
+        auto same = [](const flow_address& a, const flow_address& b) {
+            return a.family == b.family && std::memcmp(a.addr, b.addr, sizeof(a.addr)) == 0;
+        };
+        if (flow_locked) {
+            return sport == flow_sport && dport == flow_dport && same(src, flow_src) && same(dst, flow_dst);
+        }
+        if ((filter.src_port && filter.src_port != sport) || (filter.dst_port && filter.dst_port != dport)
+                || (filter_src.family && !same(filter_src, src)) || (filter_dst.family && !same(filter_dst, dst)))
+            return false;
+        flow_locked = true;
+        flow_src = src; flow_sport = sport;
+        flow_dst = dst; flow_dport = dport;
+        return true;
+    }
+
+    inline void pcap_client::on_frame(const uint8_t* p, size_t n, int linktype, const wire_timestamp& ts)
+    {
+        int ethertype = 0;
+        switch (linktype) {
+        case 1:     // Ethernet, with any number of 802.1Q/802.1ad tags
+            if (n < 14) return;
+            ethertype = details::load_be16(p + 12);
+            p += 14; n -= 14;
+            while ((ethertype == 0x8100 || ethertype == 0x88a8) && n >= 4) {
+                ethertype = details::load_be16(p + 2);
+                p += 4; n -= 4;
+            }
+            break;
+        case 113:   // Linux cooked capture v1
+            if (n < 16) return;
+            ethertype = details::load_be16(p + 14);
+            p += 16; n -= 16;
+            break;
+        case 276:   // Linux cooked capture v2
+            if (n < 20) return;
+            ethertype = details::load_be16(p);
+            p += 20; n -= 20;
+            break;
+        case 0:     // BSD loopback
+        case 108:
+            if (n < 4) return;
+            p += 4; n -= 4;
+            break;
+        case 12:    // raw IP
+        case 14:
+        case 101:
+            break;
+        default:
+            return;
+        }
+        if (ethertype == 0 && n > 0) ethertype = (p[0] >> 4) == 6 ? 0x86dd : 0x0800;
+
+        flow_address src, dst;
+        if (ethertype == 0x0800) {
+            if (n < 20 || p[9] != IPPROTO_TCP) return;
+            // Fragments are not reassembled.
+            if (details::load_be16(p + 6) & 0x3fff) return;
+            size_t ihl = (p[0] & 0x0f) * 4;
+            size_t total = details::load_be16(p + 2);
+            if (ihl < 20 || total < ihl || total > n) return;
+            src.family = dst.family = AF_INET;
+            std::memcpy(src.addr, p + 12, 4);
+            std::memcpy(dst.addr, p + 16, 4);
+            p += ihl; n = total - ihl;
+        }
+        else if (ethertype == 0x86dd) {
+            if (n < 40 || p[6] != IPPROTO_TCP) return;
+            size_t payload = details::load_be16(p + 4);
+            if (40 + payload > n) return;
+            src.family = dst.family = AF_INET6;
+            std::memcpy(src.addr, p + 8, 16);
+            std::memcpy(dst.addr, p + 24, 16);
+            p += 40; n = payload;
+        }
+        else { return; }
+
+        if (n < 20) return;
+        size_t doff = (p[12] >> 4) * 4;
+        if (doff < 20 || doff > n) return;
+        if (!match(src, details::load_be16(p), dst, details::load_be16(p + 2))) return;
+        on_segment(details::load_be32(p + 4), p[13] & 0x02, p + doff, n - doff, ts);
+    }
+
+    inline void pcap_client::on_segment(uint32_t seq, bool syn, const uint8_t* payload, size_t len, const wire_timestamp& ts)
+    {
+        if (syn) {
+            synced = true;
+            next_seq = seq + 1;
+            out_of_order.clear();
+            out_of_order_bytes = 0;
+            return;
+        }
+        if (len == 0) return;
+        if (!synced) { synced = true; next_seq = seq; }
+
+        int64_t rel = int32_t(seq - next_seq);
+        if (rel > 0) {
+            std::string& held = out_of_order[seq];
+            if (held.size() < len) {
+                out_of_order_bytes += len - held.size();
+                held.assign(reinterpret_cast<const char*>(payload), len);
+            }
+            if (out_of_order_bytes > MAX_OUT_OF_ORDER_BYTES) skip_gap(ts);
+            return;
+        }
+        if (rel + int64_t(len) <= 0) { retransmitted += len; return; }
+        retransmitted += -rel;
+        append(payload - rel, len + rel, ts);
+        drain(ts);
+    }
+
+    inline void pcap_client::append(const uint8_t* payload, size_t len, const wire_timestamp& ts)
+    {
+        void* buffer = reinterpret_cast<void*>(rx_buffer.prefetch_tail());
+        std::memcpy(buffer, payload, len);
+        this->on_read(int(len), ts);
+        next_seq += uint32_t(len);
+        appended += int(len);
+        segments++;
+    }
+
+    inline void pcap_client::drain(const wire_timestamp& ts)
+    {
+        // Segments completed by a later arrival are stamped with its capture time.
+        bool progressed = true;
+        while (progressed && !out_of_order.empty()) {
+            progressed = false;
+            for (auto it = out_of_order.begin(); it != out_of_order.end(); ++it) {
+                int64_t rel = int32_t(it->first - next_seq);
+                if (rel > 0) continue;
+                const std::string& held = it->second;
+                int64_t len = held.size();
+                if (rel + len > 0) {
+                    retransmitted += -rel;
+                    append(reinterpret_cast<const uint8_t*>(held.data()) - rel, len + rel, ts);
+                }
+                else { retransmitted += len; }
+                out_of_order_bytes -= len;
+                out_of_order.erase(it);
+                progressed = true;
+                break;
+            }
+        }
+    }
+
+    inline void pcap_client::skip_gap(const wire_timestamp& ts)
+    {
+        if (out_of_order.empty()) return;
+        uint32_t first = out_of_order.begin()->first;
+        for (const auto& held : out_of_order) {
+            if (int32_t(held.first - next_seq) < int32_t(first - next_seq)) first = held.first;
+        }
+        lost += first - next_seq;
+        next_seq = first;
+        drain(ts);
+    }
+
+    inline int pcap_client::poll()
+    {
+        if (!this->is_active) return 0;
+
+        appended = 0;
+        segments = 0;
+        wire_timestamp ts;
+        ts.system = system_timestamp();
+        ts.hardware = frame_ts;
+        bool ended = false;
+        while (appended < this->MAX_READ_SIZE && segments < this->MAX_PENDING_READS / 2
+                && rx_buffer.free_space() >= MAX_SEGMENT_SIZE + int(MAX_OUT_OF_ORDER_BYTES)) {
+            const uint8_t* frame;
+            size_t len;
+            int linktype;
+            if (!next_frame(frame, len, linktype, ts.hardware)) { ended = true; break; }
+            frame_ts = ts.hardware;
+            on_frame(frame, len, linktype, ts);
+        }
+        if (ended && appended == 0) {
+            // Nothing will fill the remaining gaps, release what is held back.
+            while (!out_of_order.empty()) skip_gap(ts);
+            if (appended == 0) {
+                last_read_timestamp = system_timestamp();
+                disconnect();
+                error_handler(io_error::fread, "stream ended.");
+            }
+        }
+        return appended;
+    }
+
+    inline int pcap_client::send_message(const char *buffer, int size)
+    {
+        error_handler(io_error::fwrite, "pcap_client is read only: \"" + filename + "\"");
+        return 0;
+    }
+
+    inline int pcap_client::send_iov(iovec* iov, int count) { return send_message(nullptr, 0); }
+
+}
+
+namespace fixate {
+
+    namespace details {
+
+        inline std::string shm_path(const std::string& name) {
+            return name.empty() || name[0] != '/' ? "/" + name : name;
+        }
+    }
+
+    inline shm_publisher::shm_publisher(const std::string& name, size_t capacity,
+                on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb)
+        : base(), name(details::shm_path(name)), capacity(capacity)
+    {
+        this->on_connect_cb = on_connect_cb;
+        this->on_disconnect_cb = on_disconnect_cb;
+        this->on_error_cb = on_error_cb;
+        size_t page_size = sysconf(_SC_PAGESIZE);
+        if ((capacity & (capacity - 1)) != 0 || capacity % page_size != 0)
+            error_handler(EINVAL, "shm_publisher capacity must be a power of 2 multiple of the page size.");
+    }
+
+    inline shm_publisher::shm_publisher(shm_publisher&& other)
+        : base(static_cast<base&&>(other))
+    {
+        name = std::move(other.name);
+        capacity = other.capacity;
+        header = other.header; other.header = nullptr;
+        data = other.data; other.data = nullptr;
+    }
+
+    inline shm_publisher& shm_publisher::operator=(shm_publisher&& other) {
+        if (this != &other) {
+            base::operator=(std::move(static_cast<base&&>(other)));
+            name = std::move(other.name);
+            capacity = other.capacity;
+            header = other.header; other.header = nullptr;
+            data = other.data; other.data = nullptr;
+        }
+        return *this;
+    }
+
+    inline shm_publisher::~shm_publisher() { disconnect(); }
+
+    inline void shm_publisher::error_handler(int ec, const std::string& msg) {
+        if (on_error_cb) on_error_cb(ec, msg);
+        throw connection_exception(ec, msg);
+    }
+
+    inline int shm_publisher::connect()
+    {
+        int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0660);
+        if (fd < 0) error_handler(errno, "Failed to open shared memory: \"" + name + "\"");
+        if (ftruncate(fd, HEADER_SIZE + capacity) != 0) {
+            int ec = errno; close(fd);
+            error_handler(ec, "Failed to size shared memory: \"" + name + "\"");
+        }
+        char* base_ptr = details::map_mirrored(fd, HEADER_SIZE, capacity, PROT_READ | PROT_WRITE);
+        close(fd);
+        if (base_ptr == nullptr) error_handler(errno, "Failed to map shared memory: \"" + name + "\"");
+
+        header = new (base_ptr) shm_ring_header();
+        header->capacity = capacity;
+        header->write_cursor.store(0, std::memory_order_relaxed);
+        header->claim_cursor.store(0, std::memory_order_relaxed);
+        header->magic.store(shm_ring_header::MAGIC, std::memory_order_release);
+        data = base_ptr + HEADER_SIZE;
+        this->is_active = true;
+        if (on_connect_cb) on_connect_cb();
+        return 1;
+    }
+
+    inline int shm_publisher::disconnect()
+    {
+        if (!this->is_active) return !this->is_active;
+        if (on_disconnect_cb) on_disconnect_cb();
+        munmap(reinterpret_cast<char*>(header), HEADER_SIZE + 2 * capacity);
+        shm_unlink(name.c_str());
+        header = nullptr;
+        data = nullptr;
+        this->is_active = false;
+        return 1;
+    }
+
+    inline int shm_publisher::poll() { return 0; }
+
+    inline int shm_publisher::size() { return 0; }
+
+    inline int shm_publisher::send_message(const char *buffer, int size)
+    {
+        if (size <= 0 || size_t(size) > capacity / 2)
+            error_handler(EMSGSIZE, "Message does not fit in shared memory ring: \"" + name + "\"");
+        int64_t now = system_timestamp();
+        uint64_t cursor = header->write_cursor.load(std::memory_order_relaxed);
+        header->claim_cursor.store(cursor + size, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(data + (cursor & (capacity - 1)), buffer, size);
+        header->write_cursor.store(cursor + size, std::memory_order_release);
+        last_sent_timestamp = now;
+        return size;
+    }
+
+    //! Buffers are copied in one after another and published together.
+    inline int shm_publisher::send_iov(iovec* iov, int count)
+    {
+        size_t size = 0;
+        for (int i = 0; i < count; ++i) size += iov[i].iov_len;
+        if (size == 0 || size > capacity / 2)
+            error_handler(EMSGSIZE, "Message does not fit in shared memory ring: \"" + name + "\"");
+        int64_t now = system_timestamp();
+        uint64_t cursor = header->write_cursor.load(std::memory_order_relaxed);
+        uint64_t offset = cursor;
+        header->claim_cursor.store(cursor + size, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < count; ++i) {
+            std::memcpy(data + (offset & (capacity - 1)), iov[i].iov_base, iov[i].iov_len);
+            offset += iov[i].iov_len;
+        }
+        header->write_cursor.store(cursor + size, std::memory_order_release);
+        last_sent_timestamp = now;
+        return size;
+    }
+
+    inline shm_client::shm_client(const std::string& name,
+                on_connect on_connect_cb, on_disconnect on_disconnect_cb, on_error on_error_cb)
+        : base(), name(details::shm_path(name))
+    {
+        this->on_connect_cb = on_connect_cb;
+        this->on_disconnect_cb = on_disconnect_cb;
+        this->on_error_cb = on_error_cb;
+    }
+
+    inline shm_client::shm_client(shm_client&& other)
+        : base(static_cast<base&&>(other))
+    {
+        name = std::move(other.name);
+        capacity = other.capacity;
+        header = other.header; other.header = nullptr;
+        data = other.data; other.data = nullptr;
+        read_cursor = other.read_cursor;
+        write_cursor = other.write_cursor;
+    }
+
+    inline shm_client& shm_client::operator=(shm_client&& other) {
+        if (this != &other) {
+            base::operator=(std::move(static_cast<base&&>(other)));
+            name = std::move(other.name);
+            capacity = other.capacity;
+            header = other.header; other.header = nullptr;
+            data = other.data; other.data = nullptr;
+            read_cursor = other.read_cursor;
+            write_cursor = other.write_cursor;
+        }
+        return *this;
+    }
+
+    inline shm_client::~shm_client() { disconnect(); }
+
+    inline void shm_client::error_handler(int ec, const std::string& msg) {
+        if (on_error_cb) on_error_cb(ec, msg);
+        throw connection_exception(ec, msg);
+    }
+
+    inline int shm_client::connect()
+    {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) error_handler(errno, "Failed to open shared memory: \"" + name + "\"");
+        struct stat st;
+        if (fstat(fd, &st) != 0 || size_t(st.st_size) <= shm_publisher::HEADER_SIZE) {
+            close(fd);
+            error_handler(EINVAL, "Shared memory is not initialised: \"" + name + "\"");
+        }
+        capacity = st.st_size - shm_publisher::HEADER_SIZE;
+        char* base_ptr = details::map_mirrored(fd, shm_publisher::HEADER_SIZE, capacity, PROT_READ);
+        close(fd);
+        if (base_ptr == nullptr) error_handler(errno, "Failed to map shared memory: \"" + name + "\"");
+
+        header = reinterpret_cast<const shm_ring_header*>(base_ptr);
+        if (header->magic.load(std::memory_order_acquire) != shm_ring_header::MAGIC || header->capacity != capacity) {
+            munmap(base_ptr, shm_publisher::HEADER_SIZE + 2 * capacity);
+            header = nullptr;
+            error_handler(EINVAL, "Shared memory is not initialised: \"" + name + "\"");
+        }
+        data = base_ptr + shm_publisher::HEADER_SIZE;
+        read_cursor = write_cursor = header->write_cursor.load(std::memory_order_acquire);
+        this->is_active = true;
+        if (on_connect_cb) on_connect_cb();
+        return 1;
+    }
+
+    inline int shm_client::disconnect()
+    {
+        if (!this->is_active) return !this->is_active;
+        if (on_disconnect_cb) on_disconnect_cb();
+        munmap(const_cast<shm_ring_header*>(header), shm_publisher::HEADER_SIZE + 2 * capacity);
+        header = nullptr;
+        data = nullptr;
+        this->is_active = false;
+        return 1;
+    }
+
+    inline const char* shm_client::read_ptr() { return data + (read_cursor & (capacity - 1)); }
+
+    inline bool shm_client::lapped() const {
+        // Orders the loads of the parsed bytes before that of the claim.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return header->claim_cursor.load(std::memory_order_relaxed) - read_cursor > capacity;
+    }
+
+    inline int shm_client::move_head(int size) {
+        if (lapped()) {
+            disconnect();
+            error_handler(EOVERFLOW, "Consumer lapped by publisher while parsing, message may be torn: \"" + name + "\"");
+        }
+        read_cursor += size;
+        return size;
+    }
+
+    inline int shm_client::size() { return int(write_cursor - read_cursor); }
+
+    inline int shm_client::poll()
+    {
+        if (!this->is_active) return 0;
+        uint64_t cursor = header->write_cursor.load(std::memory_order_acquire);
+        if (lapped()) {
+            disconnect();
+            error_handler(EOVERFLOW, "Consumer overrun by publisher: \"" + name + "\"");
+        }
+        int bytes_read = int(cursor - write_cursor);
+        if (bytes_read > 0) {
+            write_cursor = cursor;
+            last_rx_ts.system = last_read_timestamp = system_timestamp();
+        }
+        return bytes_read;
+    }
+
+    inline int shm_client::send_message(const char *buffer, int size)
+    {
+        error_handler(EPERM, "shm_client is read only: \"" + name + "\"");
+        return 0;
+    }
+
+    inline int shm_client::send_iov(iovec* iov, int count) { return send_message(nullptr, 0); }
+
+    inline wire_timestamp shm_client::read_timestamp(int size) { return last_rx_ts; }
+
+}
+#endif
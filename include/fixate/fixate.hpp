@@ -18,9 +18,37 @@
 #include "fixate/fixmsgtype.hpp"
 #include "fixate/fixdatetime.hpp"
 #include "fixate/connection.hpp"
+#include "fixate/fixpool.hpp"
+#include "fixate/fixinstrument.hpp"
+#include "fixate/fixtimer.hpp"
+
+#include <type_traits>
 
 namespace fixate {
 
+    /**
+     * Per message information handed to visitors which accept it as a fourth
+     * argument, i.e. `operator()(MessageTypeEnum, const char*, size_t, const message_context&)`.
+     */
+    struct message_context {
+        //! Stamps of the read which delivered the last byte of the message.
+        wire_timestamp timestamp;
+        //! Id of the message's instrument when the engine has an instrument_registry.
+        instrument_registry::id_type instrument_id = instrument_registry::npos;
+    };
+
+    //! Visitors with a `flush()` are flushed whenever the engine runs out of buffered messages.
+    template <typename T, typename = void>
+    struct HasFlush : std::false_type {};
+    template <typename T>
+    struct HasFlush<T, std::void_t<decltype(std::declval<T&>().flush())>> : std::true_type {};
+
+    //! Data sources with an `arm_timer(int64_t)` are woken from `poll` for the engine's timers.
+    template <typename T, typename = void>
+    struct HasArmTimer : std::false_type {};
+    template <typename T>
+    struct HasArmTimer<T, std::void_t<decltype(std::declval<T&>().arm_timer(int64_t()))>> : std::true_type {};
+
     template <typename DataSourceType, typename MessageVisitor>
     class FixEngine
     {
@@ -41,6 +69,8 @@ namespace fixate {
         FixEngine(FixEngine&& other) {
             visitor = other.visitor;
             dataSource = other.dataSource;
+            instruments = other.instruments;
+            wheel = std::move(other.wheel);
             other.visitor = nullptr;
             other.dataSource = nullptr;
         }
@@ -48,11 +78,21 @@ namespace fixate {
             if (this != &other) {
                 visitor = other.visitor;
                 dataSource = other.dataSource;
+                instruments = other.instruments;
+                wheel = std::move(other.wheel);
                 other.visitor = nullptr;
                 other.dataSource = nullptr;
             }
             return *this;
         }
+        //! Resolve `message_context::instrument_id` of every message with `registry`.
+        void setInstrumentRegistry(const instrument_registry* registry) { instruments = registry; }
+        /**
+         * Timers run by `perform` on the session thread whenever it runs out
+         * of buffered messages. A data source with a timerfd is woken for
+         * them, others are expected to be polled in a loop.
+         */
+        timer_wheel& timers() { return wheel; }
         bool connect() {
             if (dataSource->active()) return true;
             return dataSource->connect() >= 0;
@@ -65,31 +105,71 @@ namespace fixate {
             if (dataSource->size() >= 32) {
                 MsgInitials hdr;
                 int msgLen = PeekMessage()(dataSource->read_ptr(), hdr);
-                if (dataSource->size() > msgLen) {
+                if (dataSource->size() >= msgLen) {
                     readFromSource = false;
                     MessageTypeEnum msgType = MsgTypeStringToEnum(hdr.get<MessageType>());
                     // std::cout << "Incoming Message: " << details::fixstring(dataSource->read_ptr(), msgLen) << std::endl;
-                    visitor->operator()(msgType, dataSource->read_ptr(), msgLen);
+                    if constexpr (std::is_invocable_v<MessageVisitor&, MessageTypeEnum, const char*, size_t, const message_context&>) {
+                        message_context ctx;
+                        ctx.timestamp = dataSource->read_timestamp(msgLen);
+                        if (instruments) ctx.instrument_id = instruments->find_in_message(dataSource->read_ptr(), msgLen);
+                        visitor->operator()(msgType, dataSource->read_ptr(), msgLen, ctx);
+                    }
+                    else {
+                        visitor->operator()(msgType, dataSource->read_ptr(), msgLen);
+                    }
                     dataSource->move_head(msgLen);
                     return msgLen > 0;
                 }
             }
-            if (readFromSource) dataSource->poll();
+            if (readFromSource) {
+                if constexpr (HasFlush<MessageVisitor>::value) visitor->flush();
+                if (!wheel.empty()) wheel.advance(system_timestamp());
+                // A timer may have ended the session, polling it could block for good.
+                if (!dataSource->active()) return false;
+                if constexpr (HasArmTimer<DataSourceType>::value) dataSource->arm_timer(wheel.next_deadline());
+                dataSource->poll();
+            }
             return false;
         }
+        //! Updating both, the message is rendered in a single walk over its fields, see `FixMessage::encode`.
         template <typename TFixMessage>
         size_t sendmsg(TFixMessage& msg, bool updateBodyLen = true, bool updateCheckSum = true) {
+            if (updateBodyLen && updateCheckSum) {
+                std::string_view out = msg.encode(requestBuf);
+                return dataSource->send_message(out.data(), out.size());
+            }
             int bytes = msg.dump(requestBuf, updateBodyLen, updateCheckSum);
             // std::cout << "Outgoing Message: " << details::fixstring(requestBuf, bytes) << std::endl;
             return bytes > 0 ? dataSource->send_message(requestBuf, bytes) : 0;
         }
+        /**
+         * Send `msg` with one gather write, long values such as RawData or
+         * Text are sent from the message rather than copied into `requestBuf`,
+         * see `FixMessage::dump_iov`. BodyLength and CheckSum are always set.
+         */
+        template <typename TFixMessage>
+        size_t sendmsg_iov(TFixMessage& msg) {
+            iov_writer w(requestIov, MAX_REQUEST_IOV, requestBuf, sizeof(requestBuf));
+            int bytes = msg.dump_iov(w);
+            if (bytes <= 0) return 0;
+            // Nothing was referenced, a plain send is cheaper than a gather write.
+            if (w.size() == 1) return dataSource->send_message(static_cast<const char*>(w.iov()->iov_base), bytes);
+            return dataSource->send_iov(w.iov(), w.size());
+        }
     private:
-        //! 8kb of request can be send at a time.
+        //! Buffers of a message sent by `sendmsg_iov`, well below IOV_MAX.
+        static constexpr const int MAX_REQUEST_IOV = 64;
+        //! 16kb of request can be send at a time, `sendmsg_iov` copies values
+        //! shorter than `iov_writer::REFERENCE_SIZE` into it.
         //! If you want to send more, construct message,
         //! and send using the DataSourceType handle.
-        char requestBuf[8192];
+        char requestBuf[16384];
+        iovec requestIov[MAX_REQUEST_IOV];
         MessageVisitor* visitor;
         DataSourceType* dataSource;
+        const instrument_registry* instruments = nullptr;
+        timer_wheel wheel;
     };
 
 }
@@ -12,12 +12,19 @@
 #ifndef FIXATE_FIXBASE_HPP_
 #define FIXATE_FIXBASE_HPP_
 
+#include <bit>
 #include <array>
+#include <tuple>
 #include <vector>
+#include <memory>
 #include <cstring>
 #include <string>
 #include <ctime>
 #include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <sys/uio.h>
+#include "fixate/fixdatetime.hpp"
 
 #define FIXATE_FILENAME (strrchr("/" __FILE__, '/') + 1)
 #define FIXATE_ASSERT(x, msg)                                                                                               \
@@ -31,6 +38,23 @@
         }                                                                                                                   \
     } while (0)
 
+/**
+ * Compact layout, tags live only in the type, value lengths take the
+ * smallest unsigned type able to hold them and fields are packed without
+ * per-field power of 2 alignment. Messages start on a cache line.
+ */
+#ifndef FIXATE_COMPACT_LAYOUT
+#define FIXATE_COMPACT_LAYOUT 1
+#endif
+
+#if FIXATE_COMPACT_LAYOUT
+#define FIXATE_TVP_ALIGNAS(N)
+#define FIXATE_MESSAGE_ALIGNAS alignas(64)
+#else
+#define FIXATE_TVP_ALIGNAS(N) alignas(fixate::details::largest_power_of_2_less_than<N>())
+#define FIXATE_MESSAGE_ALIGNAS
+#endif
+
 #define FIXATE_THROW(msg)                                                                                                   \
     do                                                                                                                      \
     {                                                                                                                       \
@@ -54,6 +78,10 @@ namespace fixate { namespace details {
         return largest_power_of_2_less_than<N>() << 1;
     }
 
+    //! Smallest unsigned integer type able to hold `N`.
+    template <size_t N>
+    using length_type_t = std::conditional_t<(N < 256), uint8_t, std::conditional_t<(N < 65536), uint16_t, uint32_t>>;
+
     /**
      * Integer to String conversion.
      * @param dest The pointer to output buffer.
@@ -285,14 +313,198 @@ namespace fixate {
             buffer(buffer), meta(meta) {}
     };
 
+    //! Tag number of the field at `buffer`, -1 if it doesn't start with digits and '=', or with a 0.
+    inline int peek_tag(const char* buffer) {
+        if (buffer[0] == '0') return -1;
+        int tag = 0, i = 0;
+        while (unsigned(buffer[i] - '0') < 10u) tag = tag * 10 + (buffer[i++] - '0');
+        return (i != 0 && buffer[i] == '=') ? tag : -1;
+    }
+    //! Step over the field at `pd.buffer`, for tags a parser doesn't know.
+    inline int skip_field(TvpParseData& pd) {
+        int bR = 0;
+        while (pd.buffer[bR] != SEPARATOR) bR++;
+        bR += 1;
+        pd.buffer += bR;
+        return bR;
+    }
+
+namespace details {
+
+    //! Widest of 1, 2, 4 and 8 bytes which is at most `N`.
+    template <size_t N>
+    using word_type_t = std::conditional_t<(N >= 8), uint64_t,
+        std::conditional_t<(N >= 4), uint32_t, std::conditional_t<(N >= 2), uint16_t, uint8_t>>>;
+
+    /**
+     * The "<tag>=" prefix of a field, rendered at compile time along with
+     * its checksum. `match` and `write` touch exactly its bytes, through
+     * one word, or two overlapping ones when its length isn't a power of 2,
+     * up to 15 digit tags. Nothing past the prefix is read, so a mismatch
+     * against the last field of a mapped log can't run off the mapping.
+     */
+    template <TagReference Tag, size_t TSize>
+    struct tag_prefix
+    {
+        using word_type = word_type_t<TSize + 1>;
+        static constexpr const size_t size = TSize + 1;
+        static constexpr const size_t word = sizeof(word_type);
+        static constexpr const std::array<char, size> bytes = [] {
+            std::array<char, size> b{};
+            for (size_t i = 0; i < TSize; ++i) b[i] = (*Tag)[i];
+            b[TSize] = '=';
+            return b;
+        }();
+        static constexpr const uint8_t sum = [] {
+            uint8_t s = 0;
+            for (char c : bytes) s += uint8_t(c);
+            return s;
+        }();
+        static bool match(const char* src) {
+            if constexpr (size > 2 * word) {
+                return 0 == std::memcmp(src, bytes.data(), size);
+            } else {
+                word_type a, b;
+                std::memcpy(&a, src, word);
+                std::memcpy(&b, src + size - word, word);
+                return ((a ^ first) | (b ^ last)) == 0;
+            }
+        }
+        static void write(char* dest) { std::memcpy(dest, bytes.data(), size); }
+    private:
+        static constexpr word_type word_at(size_t offset) {
+            std::array<char, word> w{};
+            for (size_t i = 0; i < word; ++i) w[i] = bytes[offset + i];
+            return std::bit_cast<word_type>(w);
+        }
+        static constexpr const word_type first = word_at(0);
+        static constexpr const word_type last = word_at(size - word);
+    };
+
+    inline uint8_t byte_sum(const char* data, size_t n) {
+        uint8_t s = 0;
+        for (size_t i = 0; i < n; ++i) s += uint8_t(data[i]);
+        return s;
+    }
+}
+
+    /**
+     * Destination of `dump_iov`, a message as `iovec`s for `writev` and
+     * `sendmsg`. Fields are rendered back to back into `scratch`, as `dump`
+     * would, and a run of them becomes one entry. Values of `threshold`
+     * bytes or more are referenced where they are stored instead, and must
+     * stay put until they are sent. Once the entries run out, references
+     * are copied into `scratch` too. The length and checksum are taken as
+     * every entry is closed, `flush` closes the last one.
+     */
+    class iov_writer
+    {
+    public:
+        //! Copying a value was faster up to 4kb and referencing it from 16kb on, 8kb about even, see BM_SendRawData.
+        static constexpr const size_t REFERENCE_SIZE = 8192;
+    public:
+        iov_writer(iovec* iov, int capacity, char* scratch, size_t size, size_t threshold = REFERENCE_SIZE)
+            : entries(iov), capacity(capacity), run(scratch), cursor(scratch), last(scratch + size), threshold(threshold) {}
+        //! Render `tvp` through its `dump`, `scratch` must have room for it.
+        template <typename TvpType>
+        void write(const TvpType& tvp) { cursor += tvp.dump(cursor); }
+        //! `n` bytes copied into scratch.
+        void copy(const char* data, size_t n) {
+            FIXATE_ASSERT(n <= size_t(last - cursor), "iov_writer scratch area is full");
+            std::memcpy(cursor, data, n);
+            cursor += n;
+        }
+        /**
+         * `n` bytes sent from where they are, if they are worth an entry of
+         * their own. Closing the run before it, the reference and the run
+         * after it take up to three entries, short of those it is copied.
+         */
+        void reference(const char* data, size_t n) {
+            if (n < threshold || count + 3 > capacity) return copy(data, n);
+            flush();
+            add(const_cast<char*>(data), n);
+        }
+        //! Keep `n` bytes of scratch in front of the entries, for `prepend`.
+        char* reserve(size_t n) {
+            FIXATE_ASSERT(count == 0 && cursor == run && n <= size_t(last - cursor), "iov_writer can only reserve room up front");
+            cursor += n;
+            run = cursor;
+            return cursor;
+        }
+        //! `n` bytes rendered right before the room left by `reserve` ends.
+        void prepend(char* data, size_t n) {
+            flush();
+            if (count == 0 || entries[0].iov_base != data + n) {
+                FIXATE_ASSERT(count < capacity, "iov_writer is out of entries");
+                std::memmove(entries + 1, entries, count * sizeof(iovec));
+                entries[0] = iovec{data + n, 0};
+                count++;
+            }
+            entries[0].iov_base = data;
+            entries[0].iov_len += n;
+            total += n;
+            checksum += details::byte_sum(data, n);
+        }
+        //! Close the run rendered so far, before reading the entries, `bytes` or `sum`.
+        void flush() {
+            if (cursor == run) return;
+            add(run, cursor - run);
+            run = cursor;
+        }
+        iovec* iov() const { return entries; }
+        int size() const { return count; }
+        size_t bytes() const { return total; }
+        uint8_t sum() const { return checksum; }
+    private:
+        void add(char* data, size_t n) {
+            iovec* tail = entries + count - 1;
+            if (count != 0 && static_cast<char*>(tail->iov_base) + tail->iov_len == data) tail->iov_len += n;
+            else {
+                FIXATE_ASSERT(count < capacity, "iov_writer is out of entries");
+                entries[count++] = iovec{data, n};
+            }
+            total += n;
+            checksum += details::byte_sum(data, n);
+        }
+    private:
+        iovec* entries;
+        int capacity;
+        int count = 0;
+        char* run;
+        char* cursor;
+        char* last;
+        size_t threshold;
+        size_t total = 0;
+        uint8_t checksum = 0;
+    };
+
+    //! Fields without a `dump_iov` of their own are rendered into scratch.
+    template <typename TvpType, typename = void>
+    struct HasDumpIov : std::false_type {};
+    template <typename TvpType>
+    struct HasDumpIov<TvpType, std::void_t<decltype(std::declval<const TvpType&>().dump_iov(std::declval<iov_writer&>()))>>
+        : std::true_type {};
+
+    template <typename TvpType>
+    inline void dump_iov(const TvpType& tvp, iov_writer& w) {
+        if constexpr (HasDumpIov<TvpType>::value) tvp.dump_iov(w);
+        else w.write(tvp);
+    }
+
     template <typename TagType, size_t VSize, TagReference Tag, size_t TSize = strlen(*Tag)>
-    struct alignas(details::largest_power_of_2_less_than<TSize + VSize + sizeof(size_t)>()) TvpStatic
+    struct FIXATE_TVP_ALIGNAS(TSize + VSize + sizeof(size_t)) TvpStatic
     {
         enum : size_t { TagSize = TSize };
         enum : size_t { ValueSize = VSize };
+#if FIXATE_COMPACT_LAYOUT
+        static constexpr const char* tag = *Tag;
+        char value[VSize];
+        details::length_type_t<VSize> usedLen = 0;
+#else
         const char* tag = *Tag;
         char value[VSize];
         size_t usedLen = 0;
+#endif
         TvpStatic() {}
         template <size_t VSizeOther>
         bool operator==(const TvpStatic<TagType, VSizeOther, Tag, TSize>& other) {
@@ -304,73 +516,123 @@ namespace fixate {
         }
         int dump(char* dest) const {
             if (usedLen == 0) return 0;
-            int bW = 0;
-            std::memcpy(dest + bW, tag, TagSize); bW += TagSize;
-            dest[bW] = '='; bW += 1;
+            Prefix::write(dest);
+            int bW = Prefix::size;
             std::memcpy(dest + bW, value, usedLen); bW += usedLen;
             dest[bW] = SEPARATOR; bW += sizeof(SEPARATOR);
             return bW;
         }
         int parse(TvpParseData& pd) {
-            int i = 0, bR = 0;
-            if (0 != std::memcmp(pd.buffer, tag, TagSize)) return bR;
-            bR += TagSize + 1;      // Tag and assign character processed.
+            if (!Prefix::match(pd.buffer)) return 0;
+            int i = 0, bR = Prefix::size;   // Tag and assign character processed.
             while (pd.buffer[bR] != SEPARATOR) value[i++] = pd.buffer[bR++];
-            bR += 1; usedLen = i;   // Tag Value Pair Separator also processed.
+            bR += 1; usedLen = i;           // Tag Value Pair Separator also processed.
             pd.buffer += bR;
             return bR;
         }
         constexpr int width() const { return (usedLen != 0) ? TSize + 1 + usedLen + 1 : 0; }
         constexpr uint8_t sum() const {
             if (usedLen == 0) return uint8_t(0);
-            uint8_t w = uint8_t(0);
-            size_t i = 0; while (i < TSize) w += tag[i++]; w += '=';
-            i = 0; while (i < usedLen) w += value[i++]; w += SEPARATOR;
+            uint8_t w = Prefix::sum;
+            size_t i = 0; while (i < usedLen) w += value[i++]; w += SEPARATOR;
             return w;
         }
+        //! The rendered "tag=", for containers which keep the value apart from the field.
+        using Prefix = details::tag_prefix<Tag, TSize>;
     };
 
-    template <typename TagType, TagReference Tag, size_t TSize = strlen(*Tag)>
+    /**
+     * Variable length value kept inline up to `InlineSize` bytes. Longer
+     * values spill to a heap buffer owned by the field. The buffer is kept
+     * and reused by later values which fit, so a field only allocates when it
+     * sees a new longest value, and is freed with the field.
+     */
+    template <typename TagType, TagReference Tag, size_t TSize = strlen(*Tag), size_t InlineSize = 48>
     struct TvpDynamic
     {
         enum : size_t { TagSize = TSize };
+        enum : size_t { InlineCapacity = InlineSize };
         size_t ValueSize = 0;
+#if FIXATE_COMPACT_LAYOUT
+        static constexpr const char* tag = *Tag;
+#else
         const char* tag = *Tag;
-        std::string value;
+#endif
         TvpDynamic() {}
+        TvpDynamic(const TvpDynamic& other) { assign(other.data(), other.ValueSize); }
+        TvpDynamic(TvpDynamic&& other) noexcept { *this = std::move(other); }
+        TvpDynamic& operator=(const TvpDynamic& other) {
+            if (this != &other) assign(other.data(), other.ValueSize);
+            return *this;
+        }
+        TvpDynamic& operator=(TvpDynamic&& other) noexcept {
+            if (this == &other) return *this;
+            if (other.ValueSize <= InlineSize) std::memcpy(inlineValue, other.inlineValue, other.ValueSize);
+            else {
+                spill = std::move(other.spill);
+                spillCapacity = other.spillCapacity;
+                other.spillCapacity = 0;
+            }
+            ValueSize = other.ValueSize;
+            other.ValueSize = 0;
+            return *this;
+        }
         bool operator==(const TvpDynamic& other) {
-            return value == other.value;
+            return ValueSize == other.ValueSize && 0 == std::memcmp(data(), other.data(), ValueSize);
         }
         bool operator!=(const TvpDynamic& other) {
             return !(*this == other);
         }
+        const char* data() const { return ValueSize <= InlineSize ? inlineValue : spill.get(); }
+        void assign(const char* src, size_t size) {
+            char* dest = inlineValue;
+            if (size > InlineSize) {
+                if (size > spillCapacity) {
+                    spill.reset(new char[size]);
+                    spillCapacity = size;
+                }
+                dest = spill.get();
+            }
+            std::memcpy(dest, src, size);
+            ValueSize = size;
+        }
         int dump(char* dest) const {
             if (ValueSize == 0) return 0;
-            int bW = 0;
-            std::memcpy(dest + bW, tag, TagSize); bW += TagSize;
-            dest[bW] = '='; bW += 1;
-            std::memcpy(dest + bW, value.c_str(), ValueSize); bW += ValueSize;
+            Prefix::write(dest);
+            int bW = Prefix::size;
+            std::memcpy(dest + bW, data(), ValueSize); bW += ValueSize;
             dest[bW] = SEPARATOR; bW += sizeof(SEPARATOR);
             return bW;
         }
+        //! A long value is referenced rather than copied.
+        void dump_iov(iov_writer& w) const {
+            if (ValueSize == 0) return;
+            w.copy(Prefix::bytes.data(), Prefix::size);
+            w.reference(data(), ValueSize);
+            w.copy(&SEPARATOR, sizeof(SEPARATOR));
+        }
         int parse(TvpParseData& pd) {
-            int bR = 0;
-            if (0 != std::memcmp(pd.buffer, tag, TagSize)) return bR;
-            bR += TagSize + 1;  // Tag and assign character processed.
-            value.reserve(64);
-            while (pd.buffer[bR] != SEPARATOR) { value.push_back(pd.buffer[bR++]); }
-            bR += 1;            // Tag Value Pair Separator also processed.
+            if (!Prefix::match(pd.buffer)) return 0;
+            const char* first = pd.buffer + Prefix::size;   // Tag and assign character processed.
+            const char* last = static_cast<const char*>(rawmemchr(first, SEPARATOR));
+            assign(first, last - first);
+            int bR = last + 1 - pd.buffer;                  // Tag Value Pair Separator also processed.
             pd.buffer += bR;
             return bR;
         }
         constexpr int width() const { return (ValueSize != 0) ? TSize + 1 + ValueSize + 1 : 0; }
         constexpr uint8_t sum() const {
             if (ValueSize == 0) return uint8_t(0);
-            uint8_t w = uint8_t(0);
-            size_t i = 0; while (i < TSize) w += tag[i++]; w += '=';
-            i = 0; while (i < ValueSize) w += value[i++]; w += SEPARATOR;
+            uint8_t w = Prefix::sum;
+            const char* value = data();
+            size_t i = 0; while (i < ValueSize) w += value[i++]; w += SEPARATOR;
             return w;
         }
+    private:
+        using Prefix = details::tag_prefix<Tag, TSize>;
+        char inlineValue[InlineSize];
+        std::unique_ptr<char[]> spill;
+        size_t spillCapacity = 0;
     };
 
     template <TagReference Tag>
@@ -398,16 +660,16 @@ namespace fixate {
             Base::usedLen = val.size();
         }
     };
-    template <TagReference Tag>
-    struct TvpStringDynamic : public TvpDynamic<TvpStringDynamic<Tag>, Tag> {
-        typedef TvpDynamic<TvpStringDynamic<Tag>, Tag> Base;
+    template <TagReference Tag, size_t InlineSize = 48>
+    struct TvpStringDynamic : public TvpDynamic<TvpStringDynamic<Tag, InlineSize>, Tag, strlen(*Tag), InlineSize> {
+        typedef TvpDynamic<TvpStringDynamic<Tag, InlineSize>, Tag, strlen(*Tag), InlineSize> Base;
         TvpStringDynamic() : Base() {}
         TvpStringDynamic(const std::string& str) : Base() { set(str); }
         TvpStringDynamic(const char* str, size_t strLen) : Base() { set(std::string_view(str, strLen)); }
         template <typename T = void>
-        std::string_view get() const { return std::string_view(Base::value, Base::ValueSize); }
+        std::string_view get() const { return std::string_view(Base::data(), Base::ValueSize); }
         template <typename T = void>
-        void set(const std::string_view& val) { Base::value = val; Base::ValueSize = val.size(); }
+        void set(const std::string_view& val) { Base::assign(val.data(), val.size()); }
     };
     template <typename IntegerType, size_t VSize, TagReference Tag>
     struct TvpInteger : public TvpStatic<TvpInteger<IntegerType, VSize, Tag>, VSize, Tag> {
@@ -431,6 +693,120 @@ namespace fixate {
         template <typename T = void>
         void set(const FloatType& val, uint8_t decimals = 4) { Base::usedLen = details::dtoa(Base::value, val, decimals); }
     };
+    /**
+     * UTCTimestamp value held as nanoseconds since epoch, so comparisons and
+     * latency arithmetic don't go through text. It is rendered at `Prec`
+     * through the thread's `utc_formatter` when the message is summed or
+     * dumped, at most once per value. A parsed value keeps its text, and
+     * its precision, until it is set again.
+     */
+    template <clock_precision Prec, TagReference Tag, size_t TSize = strlen(*Tag)>
+    struct TvpUtcTimestamp
+    {
+        enum : size_t { TagSize = TSize };
+        enum : size_t { ValueSize = 27 };
+#if FIXATE_COMPACT_LAYOUT
+        static constexpr const char* tag = *Tag;
+#else
+        const char* tag = *Tag;
+#endif
+        TvpUtcTimestamp() {}
+        TvpUtcTimestamp(int64_t ts) { set(ts); }
+        bool operator==(const TvpUtcTimestamp& other) const { return usedLen == other.usedLen && ns == other.ns; }
+        bool operator!=(const TvpUtcTimestamp& other) const { return !(*this == other); }
+        template <typename T = void>
+        int64_t get() const { return ns; }
+        template <typename T = void>
+        void set(int64_t ts) { ns = ts; usedLen = WIDTH[int(Prec)]; rendered = false; }
+        //! The current time from `system_timestamp`.
+        template <typename T = void>
+        void set() { set(system_timestamp()); }
+        std::string_view text() const { render(); return std::string_view(value, usedLen); }
+        int dump(char* dest) const {
+            if (usedLen == 0) return 0;
+            render();
+            Prefix::write(dest);
+            int bW = Prefix::size;
+            std::memcpy(dest + bW, value, usedLen); bW += usedLen;
+            dest[bW] = SEPARATOR; bW += sizeof(SEPARATOR);
+            return bW;
+        }
+        int parse(TvpParseData& pd) {
+            if (!Prefix::match(pd.buffer)) return 0;
+            const char* first = pd.buffer + Prefix::size;   // Tag and assign character processed.
+            const char* last = static_cast<const char*>(rawmemchr(first, SEPARATOR));
+            FIXATE_ASSERT(last - first <= (int64_t)ValueSize, "UTCTimestamp has at most 9 fractional digits");
+            usedLen = last - first;
+            std::memcpy(value, first, usedLen);
+            ns = strtutc(value, usedLen);
+            rendered = true;
+            int bR = last + 1 - pd.buffer;                  // Tag Value Pair Separator also processed.
+            pd.buffer += bR;
+            return bR;
+        }
+        constexpr int width() const { return (usedLen != 0) ? TSize + 1 + usedLen + 1 : 0; }
+        uint8_t sum() const {
+            if (usedLen == 0) return uint8_t(0);
+            render();
+            uint8_t w = Prefix::sum;
+            size_t i = 0; while (i < usedLen) w += value[i++]; w += SEPARATOR;
+            return w;
+        }
+    private:
+        using Prefix = details::tag_prefix<Tag, TSize>;
+        static constexpr const uint8_t WIDTH[4] = {17, 21, 24, 27};
+        void render() const {
+            if (rendered) return;
+            utc_formatter::thread_default().format<Prec>(value, ns);
+            rendered = true;
+        }
+    private:
+        int64_t ns = 0;
+        mutable char value[ValueSize];
+        uint8_t usedLen = 0;
+        mutable bool rendered = false;
+    };
+
+    /**
+     * Field whose value is fixed for the message type, e.g. BeginString,
+     * MsgType or a venue constant. The whole "<tag>=<value>\x01" and its
+     * checksum are rendered at compile time, so `dump` is one block copy,
+     * `sum` a constant and the field takes no space in the message.
+     * `parse` steps over the field, its value isn't checked.
+     */
+    template <TagReference Tag, TagReference Value, size_t TSize = strlen(*Tag), size_t VSize = strlen(*Value)>
+    struct TvpConstant
+    {
+        enum : size_t { TagSize = TSize };
+        enum : size_t { ValueSize = VSize };
+        static constexpr const TagReference tag_reference = Tag;
+        static constexpr const std::array<char, TSize + 1 + VSize + 1> bytes = [] {
+            std::array<char, TSize + 1 + VSize + 1> b{};
+            for (size_t i = 0; i < TSize; ++i) b[i] = (*Tag)[i];
+            b[TSize] = '=';
+            for (size_t i = 0; i < VSize; ++i) b[TSize + 1 + i] = (*Value)[i];
+            b[TSize + 1 + VSize] = SEPARATOR;
+            return b;
+        }();
+        static constexpr const uint8_t checksum = [] {
+            uint8_t s = 0;
+            for (char c : bytes) s += uint8_t(c);
+            return s;
+        }();
+        template <typename T = void>
+        constexpr std::string_view get() const { return std::string_view(bytes.data() + TSize + 1, VSize); }
+        int dump(char* dest) const { std::memcpy(dest, bytes.data(), bytes.size()); return bytes.size(); }
+        int parse(TvpParseData& pd) {
+            if (!details::tag_prefix<Tag, TSize>::match(pd.buffer)) return 0;
+            const char* last = static_cast<const char*>(rawmemchr(pd.buffer + TSize + 1, SEPARATOR));
+            int bR = last + 1 - pd.buffer;                  // Tag Value Pair Separator also processed.
+            pd.buffer += bR;
+            return bR;
+        }
+        constexpr int width() const { return bytes.size(); }
+        constexpr uint8_t sum() const { return checksum; }
+    };
+
     template <typename TvpType, size_t ArraySize>
     struct TvpArray
     {
@@ -447,6 +823,7 @@ namespace fixate {
         int dump(char* dest) const {
             int w = 0; for (size_t i = 0; i < usedLen; ++i) { w += data[i].dump(dest + w); } return w;
         }
+        void dump_iov(iov_writer& w) const { for (size_t i = 0; i < usedLen; ++i) fixate::dump_iov(data[i], w); }
         int parse(TvpParseData& pd) {
             FIXATE_ASSERT((pd.meta != -1) & (pd.meta <= (int64_t)Size), "TvpArray expects 0 <= size < Size");
             int w = 0; usedLen = pd.meta; for (size_t i = 0; i < usedLen; ++i) { w += data[i].parse(pd); } return w;
@@ -460,37 +837,213 @@ namespace fixate {
     private:
         std::array<TvpType, ArraySize> data;
     };
-    template <typename TvpType>
+    /**
+     * Repeating group of runtime size. Storage only grows, `Size` entries
+     * are in use and the rest are kept for later messages, so parsing
+     * groups of varying size doesn't allocate once the high-water mark is
+     * reached. `Allocator` places the storage, e.g. in an `arena`.
+     */
+    template <typename TvpType, typename Allocator = std::allocator<TvpType>>
     struct TvpVector
     {
     public:
+        using value_type = TvpType;
         size_t Size = 0;
         TvpVector() {}
+        explicit TvpVector(const Allocator& alloc) : data(alloc) {}
         TvpVector(size_t capacity) { resize(capacity); }
         TvpType& operator[](size_t i) { return data[i]; }
         const TvpType& operator[](size_t i) const { return data[i]; }
         template <typename T = void>
-        void resize(size_t capacity) { data.resize(capacity); Size = capacity; }
+        void resize(size_t capacity) { if (capacity > data.size()) data.resize(capacity); Size = capacity; }
+        template <typename T = void>
+        size_t capacity() const { return data.size(); }
         template <typename ... TArgs>
         auto get(size_t i) const { return data[i].template get<TArgs...>(); }
         template <typename ... TArgs, typename ... Args>
         void set(size_t i, Args&& ... args) { data[i].template set<TArgs...>(std::forward<Args>(args)...); Size = std::max(Size, i + 1); }
         int dump(char* dest) const {
-            int w = 0; for (const auto& t : data) { w += t.dump(dest + w); } return w;
+            int w = 0; for (size_t i = 0; i < Size; ++i) { w += data[i].dump(dest + w); } return w;
         }
+        void dump_iov(iov_writer& w) const { for (size_t i = 0; i < Size; ++i) fixate::dump_iov(data[i], w); }
         int parse(TvpParseData& pd) {
             FIXATE_ASSERT(pd.meta != -1, "TvpVector expects size >= 0");
-            data.resize(pd.meta);
-            int w = 0; for (auto& t : data) { w += t.parse(pd); } return w;
+            resize(pd.meta);
+            int w = 0; for (size_t i = 0; i < Size; ++i) { w += data[i].parse(pd); } return w;
         }
         constexpr int width() const {
-            int w = 0; for (const auto& t : data) { w += t.width(); } return w;
+            int w = 0; for (size_t i = 0; i < Size; ++i) { w += data[i].width(); } return w;
         }
         uint8_t sum() const {
-            uint8_t w = uint8_t(0); for (const auto& t : data) { w += t.sum(); } return w;
+            uint8_t w = uint8_t(0); for (size_t i = 0; i < Size; ++i) { w += data[i].sum(); } return w;
         }
     private:
-        std::vector<TvpType> data;
+        std::vector<TvpType, Allocator> data;
+    };
+
+    template <typename ... TvpTypes> struct TvpGroup;
+    template <typename T> struct IsTvpGroup : std::false_type {};
+    template <typename ... TvpTypes> struct IsTvpGroup<TvpGroup<TvpTypes...>> : std::true_type {};
+
+    //! Value type returned by `TvpType::get()`.
+    template <typename TvpType>
+    using TvpValueType = std::decay_t<decltype(std::declval<const TvpType&>().get())>;
+
+    //! Integer and floating point fields, characters are left as text.
+    template <typename TvpType>
+    constexpr bool IsNumericTvpV = std::is_arithmetic_v<TvpValueType<TvpType>> && !std::is_same_v<TvpValueType<TvpType>, char>;
+
+    //! Numeric fields kept as text in a `TvpStatic`, which `TvpColumnar` decodes into a column.
+    template <typename TvpType, typename = void>
+    struct IsColumnTvp : std::false_type {};
+    template <typename TvpType>
+    struct IsColumnTvp<TvpType, std::void_t<typename TvpType::Prefix, decltype(std::declval<TvpType&>().usedLen)>>
+        : std::bool_constant<IsNumericTvpV<TvpType>> {};
+
+    template <typename TvpGroupType, typename Allocator = std::allocator<char>> struct TvpColumnar;
+
+    /**
+     * Repeating group stored member by member (struct of arrays). Numeric
+     * members are decoded once while parsing into a contiguous column of
+     * values, their text is kept beside it in a slab of `ValueSize` bytes
+     * per entry for dumping, so neither is interleaved with the other
+     * members. Other members keep a column of field objects. Storage only
+     * grows, like `TvpVector`. Absent members read back as their previous
+     * value, as they do in `TvpVector`.
+     *
+     * Every numeric member is decoded whether it is read or not, so parsing
+     * plus a single scan is slower than with `TvpVector`, which decodes on
+     * access. Prefer `TvpVector` unless a group is scanned several times per
+     * message, see benchmark/columnar.cpp.
+     */
+    template <typename ... TvpTypes, typename Allocator>
+    struct TvpColumnar<TvpGroup<TvpTypes...>, Allocator>
+    {
+    private:
+        template <typename T>
+        using Rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+        template <typename TvpType, bool Decoded = IsColumnTvp<TvpType>::value>
+        struct Column {
+            std::vector<TvpType, Rebind<TvpType>> fields;
+            Column(const Allocator& alloc) : fields(alloc) {}
+            void resize(size_t n) { fields.resize(n); }
+            auto get(size_t i) const { return fields[i].get(); }
+            template <typename ... Args>
+            void set(size_t i, Args&& ... args) { fields[i].set(std::forward<Args>(args)...); }
+            int dump(size_t i, char* dest) const { return fields[i].dump(dest); }
+            void dump_iov(size_t i, iov_writer& w) const { fixate::dump_iov(fields[i], w); }
+            int parse(size_t i, TvpParseData& pd) { return fields[i].parse(pd); }
+            int width(size_t i) const { return fields[i].width(); }
+            uint8_t sum(size_t i) const { return fields[i].sum(); }
+        };
+        template <typename TvpType>
+        struct Column<TvpType, true> {
+            using ValueType = TvpValueType<TvpType>;
+            using Prefix = typename TvpType::Prefix;
+            static constexpr const size_t Stride = TvpType::ValueSize;
+            std::vector<ValueType, Rebind<ValueType>> values;
+            std::vector<char, Rebind<char>> chars;
+            std::vector<details::length_type_t<Stride>, Rebind<details::length_type_t<Stride>>> lengths;
+            Column(const Allocator& alloc) : values(alloc), chars(alloc), lengths(alloc) {}
+            void resize(size_t n) { values.resize(n); chars.resize(n * Stride); lengths.resize(n); }
+            ValueType get(size_t i) const { return values[i]; }
+            template <typename ... Args>
+            void set(size_t i, Args&& ... args) {
+                TvpType field;
+                field.set(std::forward<Args>(args)...);
+                std::memcpy(&chars[i * Stride], field.value, field.usedLen);
+                lengths[i] = field.usedLen;
+                values[i] = field.get();
+            }
+            int dump(size_t i, char* dest) const {
+                if (lengths[i] == 0) return 0;
+                Prefix::write(dest);
+                std::memcpy(dest + Prefix::size, &chars[i * Stride], lengths[i]);
+                dest[Prefix::size + lengths[i]] = SEPARATOR;
+                return width(i);
+            }
+            void dump_iov(size_t i, iov_writer& w) const {
+                if (lengths[i] == 0) return;
+                w.copy(Prefix::bytes.data(), Prefix::size);
+                w.copy(&chars[i * Stride], lengths[i]);
+                w.copy(&SEPARATOR, sizeof(SEPARATOR));
+            }
+            //! The value is decoded straight from the message, while it is in cache.
+            int parse(size_t i, TvpParseData& pd) {
+                if (!Prefix::match(pd.buffer)) return 0;
+                const char* first = pd.buffer + Prefix::size;
+                const char* last = static_cast<const char*>(rawmemchr(first, SEPARATOR));
+                size_t n = last - first;
+                FIXATE_ASSERT(n <= Stride, "TvpColumnar value is longer than its field's ValueSize");
+                std::memcpy(&chars[i * Stride], first, n);
+                lengths[i] = n;
+                ValueType value{};
+                if constexpr (std::is_floating_point_v<ValueType>) details::atod(first, last, value);
+                else details::atoi(first, last, value);
+                values[i] = value;
+                int bR = last + 1 - pd.buffer;
+                pd.buffer += bR;
+                return bR;
+            }
+            int width(size_t i) const { return lengths[i] != 0 ? Prefix::size + lengths[i] + 1 : 0; }
+            uint8_t sum(size_t i) const {
+                if (lengths[i] == 0) return uint8_t(0);
+                return Prefix::sum + details::byte_sum(&chars[i * Stride], lengths[i]) + uint8_t(SEPARATOR);
+            }
+        };
+        template <typename TvpType>
+        Column<TvpType>& col() { return std::get<Column<TvpType>>(columns); }
+        template <typename TvpType>
+        const Column<TvpType>& col() const { return std::get<Column<TvpType>>(columns); }
+    public:
+        static_assert(!(IsTvpGroup<TvpTypes>::value || ...), "TvpColumnar doesn't support nested groups.");
+        size_t Size = 0;
+        TvpColumnar(const Allocator& alloc = Allocator()) : columns(Column<TvpTypes>(alloc)...) {}
+        template <typename T = void>
+        void resize(size_t capacity) {
+            if (capacity > cap) { (col<TvpTypes>().resize(capacity), ...); cap = capacity; }
+            Size = capacity;
+        }
+        template <typename T = void>
+        size_t capacity() const { return cap; }
+        //! Decoded value of a numeric member, the text of any other member.
+        template <typename TvpType>
+        auto get(size_t i) const { return col<TvpType>().get(i); }
+        template <typename TvpType, typename ... Args>
+        void set(size_t i, Args&& ... args) {
+            col<TvpType>().set(i, std::forward<Args>(args)...);
+            Size = std::max(Size, i + 1);
+        }
+        //! `Size` decoded values of a numeric member, contiguous.
+        template <typename TvpType>
+        const TvpValueType<TvpType>* column() const {
+            static_assert(IsColumnTvp<TvpType>::value, "only numeric members have a decoded column.");
+            return col<TvpType>().values.data();
+        }
+        int dump(char* dest) const {
+            int w = 0;
+            for (size_t i = 0; i < Size; ++i) ((w += col<TvpTypes>().dump(i, dest + w)), ...);
+            return w;
+        }
+        void dump_iov(iov_writer& w) const {
+            for (size_t i = 0; i < Size; ++i) (col<TvpTypes>().dump_iov(i, w), ...);
+        }
+        int parse(TvpParseData& pd) {
+            FIXATE_ASSERT(pd.meta != -1, "TvpColumnar expects size >= 0");
+            resize(pd.meta);
+            int w = 0;
+            for (size_t i = 0; i < Size; ++i) ((w += col<TvpTypes>().parse(i, pd)), ...);
+            return w;
+        }
+        constexpr int width() const {
+            int w = 0; for (size_t i = 0; i < Size; ++i) ((w += col<TvpTypes>().width(i)), ...); return w;
+        }
+        uint8_t sum() const {
+            uint8_t w = uint8_t(0); for (size_t i = 0; i < Size; ++i) ((w += col<TvpTypes>().sum(i)), ...); return w;
+        }
+    private:
+        std::tuple<Column<TvpTypes>...> columns;
+        size_t cap = 0;
     };
 
     template <typename ...> struct CheckUnique;
@@ -508,9 +1061,6 @@ namespace fixate {
     template <>
     struct FirstOf<void> { using type = void; };
 
-    template <typename ... TvpTypes> struct TvpGroup;
-    template <typename T> struct IsTvpGroup : std::false_type {};
-    template <typename ... TvpTypes> struct IsTvpGroup<TvpGroup<TvpTypes...>> : std::true_type {};
 
     template<typename T>
     struct IsDerivedFromTvpGroup {
@@ -546,7 +1096,12 @@ namespace fixate {
         auto get(Args&& ... args) const { return TvpType::template get<TArgs...>(std::forward<Args>(args)...); }
         template <typename TvpType, typename ... TArgs, typename ... Args>
         void set(Args&& ... args) { return TvpType::template set<TArgs...>(std::forward<Args>(args)...); }
+        template <typename TvpType>
+        const TvpType& field() const { return *this; }
+        template <typename TvpType>
+        TvpType& field() { return *this; }
         int dump(char* dest) const { return dump_impl(dest, static_cast<const TvpTypes*>(this)...); }
+        void dump_iov(iov_writer& w) const { (fixate::dump_iov(static_cast<const TvpTypes&>(*this), w), ...); }
         int parse(const char* src) { TvpParseData pd(src, -1); return parse(pd); }
         int parse(TvpParseData& pd) { return parse_impl(pd, static_cast<TvpTypes*>(this)...); }
         template <typename TvpType>
@@ -0,0 +1,178 @@
+/**
+* @file fixate/fixbook.hpp
+* @author Mrityunjay Tripathi
+*
+* Price level (L2) order book built from the MDEntries groups of
+* MarketDataSnapshotFullRefresh and MarketDataIncrementalRefresh messages.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+#ifndef FIXATE_FIXBOOK_HPP_
+#define FIXATE_FIXBOOK_HPP_
+
+#include "fixate/fixate.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+namespace fixate {
+
+    /**
+     * Values of MDEntryType (269) and MDUpdateAction (279) the book acts on,
+     * other entry types such as trades are ignored.
+     */
+    enum class MDEntryTypeEnum : char { Bid = '0', Offer = '1' };
+    enum class MDUpdateActionEnum : char { New = '0', Change = '1', Delete = '2' };
+
+    struct BookLevel { double price; double size; };
+
+    /**
+     * One side of the book, levels sorted from worst to best so that the
+     * top of book is the last element and the updates, which mostly land
+     * near the top, move few levels. `Better` orders two prices.
+     */
+    template <typename Better>
+    class BookSide
+    {
+    public:
+        using Level = BookLevel;
+    public:
+        BookSide(size_t capacity) { mLevels.reserve(capacity); }
+        size_t size() const { return mLevels.size(); }
+        bool empty() const { return mLevels.empty(); }
+        void clear() { mLevels.clear(); }
+        //! Best level, the side must not be empty.
+        const Level& best() const { return mLevels.back(); }
+        //! `i`th level from the top.
+        const Level& operator[](size_t i) const { return mLevels[mLevels.size() - 1 - i]; }
+        //! Set the size at `price`, inserting the level if it is new. Returns its depth.
+        size_t update(double price, double size) {
+            auto it = find(price);
+            if (it != mLevels.end() && it->price == price) it->size = size;
+            else it = mLevels.insert(it, Level{price, size});
+            return mLevels.end() - 1 - it;
+        }
+        //! Remove the level at `price`, returns its depth or -1 if there was none.
+        int remove(double price) {
+            auto it = find(price);
+            if (it == mLevels.end() || it->price != price) return -1;
+            int depth = mLevels.end() - 1 - it;
+            mLevels.erase(it);
+            return depth;
+        }
+        //! Keep the best `depth` levels.
+        void truncate(size_t depth) {
+            if (mLevels.size() > depth) mLevels.erase(mLevels.begin(), mLevels.end() - depth);
+        }
+    private:
+        typename std::vector<Level>::iterator find(double price) {
+            // Worse prices first, the first level not worse than `price`.
+            return std::lower_bound(mLevels.begin(), mLevels.end(), price,
+                    [](const Level& l, double p) { return Better()(p, l.price); });
+        }
+    private:
+        std::vector<Level> mLevels;
+    };
+
+    /**
+     * Aggregated book of one instrument. With `MDImplicitDelete` in effect
+     * the counterparty doesn't send deletes for levels pushed out of the
+     * subscribed `depth`, the book drops them itself; a snapshot replaces
+     * the whole book. Level storage is reserved up front so that updates
+     * within the expected depth don't allocate.
+     */
+    class OrderBook
+    {
+    public:
+        using BidSide = BookSide<std::greater<double>>;
+        using OfferSide = BookSide<std::less<double>>;
+        using Level = BookLevel;
+        static constexpr const size_t DEFAULT_CAPACITY = 256;
+    public:
+        /**
+         * @param depth Subscribed MarketDepth, 0 for the full book.
+         * @param implicitDelete Whether MDImplicitDelete (547) is in effect.
+         */
+        OrderBook(size_t depth = 0, bool implicitDelete = false)
+            : mBids(std::max(DEFAULT_CAPACITY, depth + 1)), mOffers(std::max(DEFAULT_CAPACITY, depth + 1)),
+              mDepth(depth), mImplicitDelete(implicitDelete) {}
+
+        void setImplicitDelete(bool implicitDelete) { mImplicitDelete = implicitDelete; trim(); }
+        void clear() { mBids.clear(); mOffers.clear(); }
+        const BidSide& bids() const { return mBids; }
+        const OfferSide& offers() const { return mOffers; }
+        //! Top of book, `{0, 0}` for an empty side.
+        Level bestBid() const { return mBids.empty() ? Level{0.0, 0.0} : mBids.best(); }
+        Level bestOffer() const { return mOffers.empty() ? Level{0.0, 0.0} : mOffers.best(); }
+        //! Number of entries applied so far.
+        uint64_t updates() const { return mUpdates; }
+
+        /**
+         * Apply one MDEntries entry. A zero size change deletes the level.
+         * Returns true if the top of book changed.
+         */
+        bool update(char entryType, char updateAction, double price, double size) {
+            if (entryType == char(MDEntryTypeEnum::Bid)) return apply(mBids, updateAction, price, size);
+            if (entryType == char(MDEntryTypeEnum::Offer)) return apply(mOffers, updateAction, price, size);
+            return false;
+        }
+
+        /**
+         * Replace the book with the `Group` (e.g. `TvpVector<TvpGroup<MDEntryType,
+         * MDEntryPx, MDEntrySize, ...>>`) of a MarketDataSnapshotFullRefresh.
+         */
+        template <typename Group, typename TMessage>
+        void onSnapshot(const TMessage& msg) {
+            clear();
+            int64_t n = msg.template get<NoMDEntries>();
+            for (int64_t i = 0; i < n; ++i) {
+                update(msg.template get<Group, MDEntryType>(i), char(MDUpdateActionEnum::New),
+                        msg.template get<Group, MDEntryPx>(i), msg.template get<Group, MDEntrySize>(i));
+            }
+        }
+
+        /**
+         * Apply the `Group` of a MarketDataIncrementalRefresh, which must
+         * carry MDUpdateAction. Returns true if the top of book changed.
+         */
+        template <typename Group, typename TMessage>
+        bool onIncremental(const TMessage& msg) {
+            bool top = false;
+            int64_t n = msg.template get<NoMDEntries>();
+            for (int64_t i = 0; i < n; ++i) {
+                top |= update(msg.template get<Group, MDEntryType>(i), msg.template get<Group, MDUpdateAction>(i),
+                        msg.template get<Group, MDEntryPx>(i), msg.template get<Group, MDEntrySize>(i));
+            }
+            return top;
+        }
+    private:
+        template <typename Side>
+        bool apply(Side& side, char updateAction, double price, double size) {
+            mUpdates++;
+            if (updateAction == char(MDUpdateActionEnum::Delete) || size == 0.0) return side.remove(price) == 0;
+            bool top = side.update(price, size) == 0;
+            if (mImplicitDelete && mDepth != 0) side.truncate(mDepth);
+            return top;
+        }
+        void trim() {
+            if (!mImplicitDelete || mDepth == 0) return;
+            mBids.truncate(mDepth);
+            mOffers.truncate(mDepth);
+        }
+    private:
+        BidSide mBids;
+        OfferSide mOffers;
+        size_t mDepth;
+        bool mImplicitDelete;
+        uint64_t mUpdates = 0;
+    };
+
+}
+
+#endif
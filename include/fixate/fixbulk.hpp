@@ -0,0 +1,194 @@
+/**
+* @file fixate/fixbulk.hpp
+* @author Mrityunjay Tripathi
+*
+* Offline bulk parsing, a large FIX log is mapped into memory, split into
+* chunks on message boundaries and every chunk is run through its own
+* FixEngine on a pool of threads.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+#ifndef FIXATE_FIXBULK_HPP_
+#define FIXATE_FIXBULK_HPP_
+
+#include "fixate/fixate.hpp"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <climits>
+#include <cstring>
+#include <exception>
+
+namespace fixate {
+
+    /**
+     * Read only memory map of a whole file.
+     */
+    class mapped_file {
+    public:
+        explicit mapped_file(const std::string& filename);
+        mapped_file(const mapped_file& other) = delete;
+        mapped_file& operator=(const mapped_file& other) = delete;
+        ~mapped_file();
+        const char* data() const { return ptr; }
+        size_t size() const { return len; }
+    private:
+        const char* ptr = nullptr;
+        size_t len = 0;
+    };
+
+    /**
+     * Data source over a byte range which is already in memory. Messages are
+     * handed to the visitor in place, the stream ends with the range.
+     */
+    class mapped_chunk {
+    public:
+        mapped_chunk() {}
+        mapped_chunk(const char* begin, const char* end) : head(begin), tail(end) {}
+        int connect() { is_active = head < tail; return is_active ? 1 : -1; }
+        int disconnect() { is_active = false; return 1; }
+        bool active() const { return is_active; }
+        const char* read_ptr() { return head; }
+        int move_head(int size) { head += size; return size; }
+        int size() { return int(std::min<ptrdiff_t>(tail - head, INT_MAX)); }
+        //! Nothing more will arrive, a trailing partial message ends the stream.
+        int poll() { is_active = false; return 0; }
+        int send_message(const char* buffer, int size) {
+            throw connection_exception(EPERM, "mapped_chunk is read only.");
+        }
+        wire_timestamp read_timestamp(int size) { return wire_timestamp(); }
+        //! Bytes left over, non zero if the chunk ended in a partial message.
+        size_t remaining() const { return tail - head; }
+    private:
+        const char* head = nullptr;
+        const char* tail = nullptr;
+        bool is_active = false;
+    };
+
+    /**
+     * Split `[data, data + size)` into at most `count` chunks, every chunk
+     * starting at a `8=FIX` which is either at the start of the buffer or
+     * right after a SOH.
+     */
+    inline std::vector<std::pair<const char*, const char*>>
+    split_chunks(const char* data, size_t size, size_t count)
+    {
+        auto resync = [data, size](size_t pos) {
+            const char* end = data + size;
+            const char* p = data + pos;
+            while (p < end) {
+                p = static_cast<const char*>(std::memchr(p, '8', end - p));
+                if (p == nullptr) return end;
+                if ((p == data || p[-1] == '\x01') && size_t(end - p) >= 5 && std::memcmp(p, "8=FIX", 5) == 0)
+                    return p;
+                ++p;
+            }
+            return end;
+        };
+        std::vector<std::pair<const char*, const char*>> chunks;
+        if (size == 0 || count == 0) return chunks;
+        const char* begin = resync(0);
+        for (size_t i = 1; i <= count; ++i) {
+            const char* end = i == count ? data + size : resync(size / count * i);
+            if (end > begin) {
+                chunks.emplace_back(begin, end);
+                begin = end;
+            }
+        }
+        return chunks;
+    }
+
+    /**
+     * Parse `[data, data + size)` on `threads` threads (all cores if 0). The
+     * buffer is split into a few chunks per thread so that uneven chunks
+     * balance out, every chunk gets its own visitor made by `make_visitor`.
+     * Visitors are returned in file order.
+     */
+    template <typename MessageVisitor, typename VisitorFactory>
+    std::vector<MessageVisitor> parse_parallel(const char* data, size_t size, size_t threads, VisitorFactory make_visitor)
+    {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        auto chunks = split_chunks(data, size, threads == 1 ? 1 : threads * 4);
+        std::vector<MessageVisitor> visitors;
+        visitors.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) visitors.emplace_back(make_visitor());
+
+        std::atomic<size_t> next{0};
+        std::exception_ptr failure;
+        std::mutex failure_lock;
+        auto worker = [&]() {
+            for (size_t i = next++; i < chunks.size(); i = next++) {
+                try {
+                    mapped_chunk source(chunks[i].first, chunks[i].second);
+                    FixEngine<mapped_chunk, MessageVisitor> engine(&source, &visitors[i]);
+                    engine.connect();
+                    while (source.active()) engine.perform();
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> guard(failure_lock);
+                    if (!failure) failure = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < std::min(threads, chunks.size()); ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& t : pool) t.join();
+        if (failure) std::rethrow_exception(failure);
+        return visitors;
+    }
+
+    template <typename MessageVisitor>
+    std::vector<MessageVisitor> parse_parallel(const char* data, size_t size, size_t threads = 0)
+    {
+        return parse_parallel<MessageVisitor>(data, size, threads, [](){ return MessageVisitor(); });
+    }
+
+    /**
+     * As above, folding the per chunk visitors in file order with
+     * `merge(MessageVisitor& into, MessageVisitor&& next)`.
+     */
+    template <typename MessageVisitor, typename VisitorFactory, typename Merge>
+    MessageVisitor parse_parallel(const char* data, size_t size, size_t threads, VisitorFactory make_visitor, Merge merge)
+    {
+        auto visitors = parse_parallel<MessageVisitor>(data, size, threads, make_visitor);
+        if (visitors.empty()) return make_visitor();
+        for (size_t i = 1; i < visitors.size(); ++i) merge(visitors.front(), std::move(visitors[i]));
+        return std::move(visitors.front());
+    }
+
+    inline mapped_file::mapped_file(const std::string& filename)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) throw connection_exception(errno, "Failed to open file: \"" + filename + "\"");
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            int ec = errno; close(fd);
+            throw connection_exception(ec, "Failed to stat file: \"" + filename + "\"");
+        }
+        len = st.st_size;
+        if (len > 0) {
+            void* addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                int ec = errno; close(fd);
+                throw connection_exception(ec, "Failed to map file: \"" + filename + "\"");
+            }
+            madvise(addr, len, MADV_SEQUENTIAL);
+            ptr = static_cast<const char*>(addr);
+        }
+        close(fd);
+    }
+
+    inline mapped_file::~mapped_file() {
+        if (ptr) munmap(const_cast<char*>(ptr), len);
+    }
+
+}
+
+#endif
@@ -0,0 +1,219 @@
+/**
+* @file fixate/fixclock.hpp
+* @author Mrityunjay Tripathi
+*
+* Clock sources behind `system_timestamp`, CLOCK_REALTIME through the vDSO
+* or the invariant TSC calibrated against it.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+#ifndef FIXATE_FIXCLOCK_HPP_
+#define FIXATE_FIXCLOCK_HPP_
+
+#include <time.h>
+#include <atomic>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+/**
+ * Clock source `system_timestamp` starts with, 1 for the TSC where it is
+ * invariant. Can be changed at runtime with `set_clock_source`.
+ */
+#ifndef FIXATE_TSC_CLOCK
+#define FIXATE_TSC_CLOCK 0
+#endif
+
+namespace fixate {
+
+enum class clock_source { realtime = 0, tsc = 1 };
+
+namespace details {
+    __extension__ typedef unsigned __int128 uint128_t;
+}
+
+/**
+ * Nanoseconds since epoch from CLOCK_REALTIME.
+ */
+inline int64_t realtime_timestamp() {
+    timespec ts;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+    return int64_t(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * CLOCK_REALTIME extrapolated from the time stamp counter. A reading is
+ * `base_ns + (rdtsc() - base_tsc) * mult >> 32`. The calibration is
+ * measured once against CLOCK_REALTIME and then, every `resync_ns`, the
+ * first reader past the deadline takes a fresh CLOCK_REALTIME sample,
+ * re-anchors on it and refines `mult` over the whole time since the first
+ * sample, which corrects drift; a step of the system clock restarts the
+ * baseline. The calibration is published through a seqlock, readers never
+ * block on the writer and only retry if they raced with it.
+ */
+class tsc_clock
+{
+public:
+    static constexpr const int64_t DEFAULT_RESYNC_NS = 1000000000LL;
+public:
+    explicit tsc_clock(int64_t resync_ns = DEFAULT_RESYNC_NS);
+    tsc_clock(const tsc_clock& other) = delete;
+    tsc_clock& operator=(const tsc_clock& other) = delete;
+
+    //! True if the CPU has a TSC which ticks at a constant rate in every P/C state.
+    static bool supported();
+    //! Clock shared by `system_timestamp`.
+    static tsc_clock& instance() {
+        static tsc_clock clock;
+        return clock;
+    }
+    static uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+    //! Nanoseconds since epoch.
+    int64_t now();
+    //! Convert a `ticks()` reading taken within the current calibration.
+    int64_t to_nanoseconds(uint64_t tsc) const;
+    //! Resample CLOCK_REALTIME now rather than at the next deadline.
+    void resync() { update(ticks(), true); }
+    //! Ticks per second of the current calibration.
+    double frequency() const { return 4294967296.0 * 1e9 / double(mult.load(std::memory_order_relaxed)); }
+private:
+    //! CLOCK_REALTIME with the TSC reading at the middle of the call.
+    static int64_t sample(uint64_t& tsc);
+    void update(uint64_t tsc, bool force);
+private:
+    int64_t resyncNs;
+    uint64_t resyncTicks;
+    //! First sample, the baseline for the rate.
+    uint64_t originTsc;
+    int64_t originNs;
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint64_t> baseTsc{0};
+    std::atomic<int64_t> baseNs{0};
+    //! Nanoseconds per tick in 32.32 fixed point.
+    std::atomic<uint64_t> mult{0};
+    std::atomic<uint64_t> deadline{0};
+};
+
+namespace details {
+    inline std::atomic<clock_source>& current_clock_source() {
+        static std::atomic<clock_source> source{
+            FIXATE_TSC_CLOCK && tsc_clock::supported() ? clock_source::tsc : clock_source::realtime};
+        return source;
+    }
+}
+
+/**
+ * Select the clock of `system_timestamp` for all threads. Returns false,
+ * leaving the source unchanged, if the TSC isn't usable on this machine.
+ */
+inline bool set_clock_source(clock_source source) {
+    if (source == clock_source::tsc && !tsc_clock::supported()) return false;
+    if (source == clock_source::tsc) tsc_clock::instance();
+    details::current_clock_source().store(source, std::memory_order_release);
+    return true;
+}
+inline clock_source get_clock_source() {
+    return details::current_clock_source().load(std::memory_order_relaxed);
+}
+
+inline bool tsc_clock::supported() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) return false;
+    __cpuid(0x80000007, eax, ebx, ecx, edx);
+    return edx & (1u << 8);
+#else
+    return false;
+#endif
+}
+
+inline int64_t tsc_clock::sample(uint64_t& tsc) {
+    // The tightest of a few bracketed reads, an interrupt can land in any one.
+    uint64_t best = UINT64_MAX;
+    int64_t ns = 0;
+    for (int i = 0; i < 5; ++i) {
+        uint64_t before = ticks();
+        int64_t t = realtime_timestamp();
+        uint64_t after = ticks();
+        if (after - before < best) { best = after - before; ns = t; tsc = before + (after - before) / 2; }
+    }
+    return ns;
+}
+
+inline tsc_clock::tsc_clock(int64_t resync_ns) : resyncNs(resync_ns) {
+    originNs = sample(originTsc);
+    // Initial rate over 10ms, refined on every resync.
+    uint64_t tsc = 0;
+    int64_t ns;
+    do { ns = sample(tsc); } while (ns - originNs < 10000000LL);
+    uint64_t m = uint64_t((details::uint128_t)(ns - originNs) << 32) / (tsc - originTsc);
+    resyncTicks = uint64_t((details::uint128_t)resyncNs << 32) / m;
+    mult.store(m, std::memory_order_relaxed);
+    baseTsc.store(tsc, std::memory_order_relaxed);
+    baseNs.store(ns, std::memory_order_relaxed);
+    deadline.store(tsc + resyncTicks, std::memory_order_release);
+}
+
+inline int64_t tsc_clock::to_nanoseconds(uint64_t tsc) const {
+    uint32_t s;
+    uint64_t t, m;
+    int64_t ns;
+    do {
+        s = seq.load(std::memory_order_acquire);
+        t = baseTsc.load(std::memory_order_relaxed);
+        ns = baseNs.load(std::memory_order_relaxed);
+        m = mult.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((s & 1) || seq.load(std::memory_order_relaxed) != s);
+    // Readings taken before the base are possible around a resync.
+    if (tsc < t) return ns - int64_t(((details::uint128_t)(t - tsc) * m) >> 32);
+    return ns + int64_t(((details::uint128_t)(tsc - t) * m) >> 32);
+}
+
+inline int64_t tsc_clock::now() {
+    uint64_t tsc = ticks();
+    if (tsc >= deadline.load(std::memory_order_relaxed)) update(tsc, false);
+    return to_nanoseconds(tsc);
+}
+
+inline void tsc_clock::update(uint64_t tsc, bool force) {
+    uint32_t s = seq.load(std::memory_order_relaxed);
+    // One writer at a time, the others keep the current calibration.
+    if ((s & 1) || !seq.compare_exchange_strong(s, s + 1, std::memory_order_acquire)) return;
+    if (!force && tsc < deadline.load(std::memory_order_relaxed)) {
+        seq.store(s + 2, std::memory_order_release);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    uint64_t now = 0;
+    int64_t ns = sample(now);
+    uint64_t m = mult.load(std::memory_order_relaxed);
+    uint64_t refined = m;
+    if (ns > originNs && now > originTsc)
+        refined = uint64_t((details::uint128_t)(ns - originNs) << 32) / (now - originTsc);
+    // More than 0.1% off means the system clock was stepped, start a new baseline.
+    if (refined > m + m / 1000 || refined + m / 1000 < m) { originTsc = now; originNs = ns; }
+    else m = refined;
+    mult.store(m, std::memory_order_relaxed);
+    baseTsc.store(now, std::memory_order_relaxed);
+    baseNs.store(ns, std::memory_order_relaxed);
+    deadline.store(now + resyncTicks, std::memory_order_relaxed);
+    seq.store(s + 2, std::memory_order_release);
+}
+
+}
+
+#endif
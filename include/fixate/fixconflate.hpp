@@ -0,0 +1,160 @@
+/**
+* @file fixate/fixconflate.hpp
+* @author Mrityunjay Tripathi
+*
+* Conflation of market data for consumers which fall behind the feed,
+* queued incremental refreshes are merged per instrument and price level.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+#ifndef FIXATE_FIXCONFLATE_HPP_
+#define FIXATE_FIXCONFLATE_HPP_
+
+#include "fixate/fixate.hpp"
+#include "fixate/fixbook.hpp"
+
+#include <vector>
+
+namespace fixate {
+
+    struct conflation_stats {
+        uint64_t messages_in = 0;
+        uint64_t messages_out = 0;
+        //! MDEntries received and handed on, the difference was merged away.
+        uint64_t updates_in = 0;
+        uint64_t updates_out = 0;
+        uint64_t merged() const { return updates_in - updates_out; }
+    };
+
+    /**
+     * Visitor adapter between the FixEngine and a `MessageVisitor`. Incremental
+     * refreshes (`TMessage`, with its MDEntries `Group`) are not handed on
+     * as they arrive. Their entries are merged per instrument and price
+     * level, a later size replaces an earlier one, and delivered as one
+     * refresh per instrument when the engine runs out of buffered messages
+     * (`flush`), so a consumer which fell behind skips straight to the
+     * latest state. Any other message flushes first, to keep its order
+     * relative to market data, and `maxPending` bounds how much is held.
+     * Trades and other entry types are passed on unmerged. A merged refresh
+     * carries the session header, MDReqID and Symbol of the latest input,
+     * other message level fields are not kept. The engine's registry, if it
+     * has one, must be `registry`.
+     */
+    template <typename MessageVisitor, typename TMessage, typename Group>
+    class ConflatingVisitor
+    {
+        using Entry = typename Group::value_type;
+        static constexpr bool SymbolInGroup = std::is_base_of_v<Symbol, Entry>;
+        static_assert(SymbolInGroup || TMessage::template has<Symbol>(), "refreshes must carry a Symbol.");
+    public:
+        ConflatingVisitor(MessageVisitor* visitor, instrument_registry* registry, size_t maxPending = 4096)
+            : mVisitor(visitor), mRegistry(registry), mPending(registry->capacity()), mMaxPending(maxPending) {}
+
+        void operator()(MessageTypeEnum msgType, const char* buffer, size_t n, const message_context& ctx) {
+            mStats.messages_in++;
+            if (msgType != MessageTypeEnum::MarketDataIncrementalRefresh) {
+                flush();
+                forward(msgType, buffer, n, ctx);
+                mStats.messages_out++;
+                return;
+            }
+            mIncoming.parse(buffer);
+            mLast = ctx;
+            instrument_registry::id_type id = ctx.instrument_id;
+            if constexpr (!SymbolInGroup) {
+                if (id == instrument_registry::npos) id = mRegistry->intern(mIncoming.template get<Symbol>());
+            }
+            int64_t entries = mIncoming.template get<NoMDEntries>();
+            const Group& group = mIncoming.template field<Group>();
+            for (int64_t i = 0; i < entries; ++i) {
+                if constexpr (SymbolInGroup) id = mRegistry->intern(group[i].template get<Symbol>());
+                if (id == instrument_registry::npos) continue;
+                merge(id, group[i]);
+            }
+            mStats.updates_in += entries;
+            if (mHeld >= mMaxPending) flush();
+        }
+
+        //! Hand on one merged refresh per instrument with pending updates.
+        void flush() {
+            for (instrument_registry::id_type id : mDirty) {
+                auto& pending = mPending[id];
+                if constexpr (TMessage::template has<MsgSeqNum>()) mOutgoing.template field<MsgSeqNum>() = mIncoming.template field<MsgSeqNum>();
+                if constexpr (TMessage::template has<SenderCompId>()) mOutgoing.template field<SenderCompId>() = mIncoming.template field<SenderCompId>();
+                if constexpr (TMessage::template has<TargetCompId>()) mOutgoing.template field<TargetCompId>() = mIncoming.template field<TargetCompId>();
+                if constexpr (TMessage::template has<SendingTime>()) mOutgoing.template field<SendingTime>() = mIncoming.template field<SendingTime>();
+                if constexpr (TMessage::template has<MDReqID>()) mOutgoing.template field<MDReqID>() = mIncoming.template field<MDReqID>();
+                if constexpr (!SymbolInGroup) mOutgoing.template set<Symbol>(mRegistry->name(id));
+                mOutgoing.template set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+                mOutgoing.template set<NoMDEntries>(int64_t(pending.size()));
+                mOutgoing.template resize<Group>(pending.size());
+                Group& group = mOutgoing.template field<Group>();
+                for (size_t i = 0; i < pending.size(); ++i) group[i] = pending[i].entry;
+                size_t width = mOutgoing.updateBodyLength() + 64;
+                if (mBuffer.size() < width) mBuffer.resize(width);
+                int bytes = mOutgoing.dump(mBuffer.data(), false, true);
+                message_context ctx = mLast;
+                ctx.instrument_id = id;
+                forward(MessageTypeEnum::MarketDataIncrementalRefresh, mBuffer.data(), bytes, ctx);
+                mStats.messages_out++;
+                mStats.updates_out += pending.size();
+                pending.clear();
+            }
+            mDirty.clear();
+            mHeld = 0;
+        }
+        const conflation_stats& stats() const { return mStats; }
+    private:
+        struct Pending {
+            char type;
+            double price;
+            Entry entry;
+        };
+        void merge(instrument_registry::id_type id, const Entry& entry) {
+            auto& pending = mPending[id];
+            if (pending.empty()) mDirty.push_back(id);
+            char type = entry.template get<MDEntryType>();
+            double price = entry.template get<MDEntryPx>();
+            bool level = type == char(MDEntryTypeEnum::Bid) || type == char(MDEntryTypeEnum::Offer);
+            if (level) {
+                for (auto& p : pending) {
+                    if (p.type != type || p.price != price) continue;
+                    // A level added within the window stays new, whatever its later changes.
+                    char action = entry.template get<MDUpdateAction>();
+                    bool added = p.entry.template get<MDUpdateAction>() == char(MDUpdateActionEnum::New);
+                    p.entry = entry;
+                    if (added && action == char(MDUpdateActionEnum::Change)) p.entry.template set<MDUpdateAction>(char(MDUpdateActionEnum::New));
+                    return;
+                }
+            }
+            pending.push_back(Pending{type, price, entry});
+            mHeld++;
+        }
+        void forward(MessageTypeEnum msgType, const char* buffer, size_t n, const message_context& ctx) {
+            if constexpr (std::is_invocable_v<MessageVisitor&, MessageTypeEnum, const char*, size_t, const message_context&>)
+                mVisitor->operator()(msgType, buffer, n, ctx);
+            else
+                mVisitor->operator()(msgType, buffer, n);
+        }
+    private:
+        MessageVisitor* mVisitor;
+        instrument_registry* mRegistry;
+        std::vector<std::vector<Pending>> mPending;
+        std::vector<instrument_registry::id_type> mDirty;
+        size_t mHeld = 0;
+        size_t mMaxPending;
+        TMessage mIncoming;
+        TMessage mOutgoing;
+        message_context mLast;
+        conflation_stats mStats;
+        std::vector<char> mBuffer;
+    };
+
+}
+
+#endif
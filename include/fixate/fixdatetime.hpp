@@ -15,6 +15,9 @@
 #include <ctime>
 #include <time.h>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "fixate/fixclock.hpp"
 
 namespace fixate {
 
@@ -29,17 +32,56 @@ namespace details {
     template <clock_precision Prec>
     inline size_t strfepoch(char* dest, std::tm* t, int64_t ts);
 
-    template <typename Func>
-    inline int64_t strtepoch(const char *src, int size, Func&& f);
+    //! Fields of a `YYYYMMDD-HH:MM:SS[.s...]` timestamp.
+    struct civil_time {
+        int year, month, day, hour, minute, second;
+        int64_t nanos;
+    };
+    inline bool strtcivil(const char* src, int size, civil_time& t);
+    inline int64_t days_from_civil(int year, int month, int day);
+
+    //! "00", "01", ... "99" back to back.
+    struct digit_pair_table {
+        char pairs[200];
+        constexpr digit_pair_table() : pairs() {
+            for (int i = 0; i < 100; ++i) { pairs[2 * i] = char('0' + i / 10); pairs[2 * i + 1] = char('0' + i % 10); }
+        }
+    };
+    inline constexpr digit_pair_table digit_pairs{};
+
+    inline void write_2digits(char* dest, unsigned v) { std::memcpy(dest, &digit_pairs.pairs[2 * v], 2); }
+    inline void write_3digits(char* dest, unsigned v) { dest[0] = char('0' + v / 100); write_2digits(dest + 1, v % 100); }
 }
 
 /**
- * Returns the current epoch, from 01/01/1970.
+ * UTC formatting which renders `YYYYMMDD-HH:MM:SS` once per second and
+ * only writes the sub-second digits for later stamps of the same second.
+ * Output is the same as `strfutc`. One instance per thread, see
+ * `thread_default`.
+ */
+class utc_formatter
+{
+public:
+    template <clock_precision Prec>
+    size_t format(char* dest, int64_t ts);
+    //! Formatter of the calling thread.
+    static utc_formatter& thread_default() {
+        static thread_local utc_formatter f;
+        return f;
+    }
+private:
+    void render(int64_t second);
+private:
+    int64_t cachedSecond = -1;
+    char prefix[17];
+};
+
+/**
+ * Returns the current epoch, from 01/01/1970, from the selected `clock_source`.
  */
 inline int64_t system_timestamp() {
-    timespec ts;
-    ::clock_gettime(CLOCK_REALTIME, &ts);
-    return (int64_t)ts.tv_sec * 1e+9 + ts.tv_nsec;
+    if (get_clock_source() == clock_source::tsc) return tsc_clock::instance().now();
+    return realtime_timestamp();
 }
 /**
  * Returns the current unix epoch, from 01/01/1970.
@@ -55,8 +97,9 @@ inline int64_t epoch_timestamp() {
 template <clock_precision Prec>
 inline size_t strfutc(char* dest, int64_t ts) {
     std::time_t t = ts / 1000000000LL;
-    std::tm* gm_time = std::gmtime(&t);
-    return details::strfepoch<Prec>(dest, gm_time, ts);
+    std::tm gm_time;
+    gmtime_r(&t, &gm_time);
+    return details::strfepoch<Prec>(dest, &gm_time, ts);
 }
 template <clock_precision Prec>
 inline size_t strfutc(std::string& dest, int64_t ts) {
@@ -119,13 +162,35 @@ inline size_t strfutc(std::string_view dest, char prec = 's') {
     return strfutc(dest.data(), epoch_timestamp(), prec);
 }
 /**
- * @description Converts given string in utc time to epoch.
+ * @description Same as `strfutc`, through the calling thread's `utc_formatter`.
+ * @param dest The address to output buffer.
+ * @param ts The epoch timestamp.
+ */
+template <clock_precision Prec>
+inline size_t strfutc_cached(char* dest, int64_t ts) {
+    return utc_formatter::thread_default().format<Prec>(dest, ts);
+}
+inline size_t strfutc_cached(char* dest, int64_t ts, char prec = 's') {
+    if (prec == 's') return strfutc_cached<clock_precision::seconds>(dest, ts);
+    else if (prec == 'm') return strfutc_cached<clock_precision::milliseconds>(dest, ts);
+    else if (prec == 'u') return strfutc_cached<clock_precision::microseconds>(dest, ts);
+    else if (prec == 'n') return strfutc_cached<clock_precision::nanoseconds>(dest, ts);
+    else return 0;
+}
+//! Returned by `strtutc` and `strtlocal` for malformed input.
+inline constexpr const int64_t INVALID_TIMESTAMP = INT64_MIN;
+/**
+ * @description Converts given string in utc time, with 0 to 9 fractional
+ * digits, to nanoseconds since epoch. INVALID_TIMESTAMP if it is malformed.
  * @param src The address of input buffer.
  * @param size The size of input buffer.
  */
 inline int64_t strtutc(const char* src, int size) {
-    auto f = [](struct tm* t) { return timegm(t); };
-    return details::strtepoch(src, size, f);
+    details::civil_time t;
+    if (!details::strtcivil(src, size, t)) return INVALID_TIMESTAMP;
+    int64_t seconds = details::days_from_civil(t.year, t.month, t.day) * 86400
+            + t.hour * 3600 + t.minute * 60 + t.second;
+    return seconds * 1000000000LL + t.nanos;
 }
 inline int64_t strtutc(const std::string& src) {
     return strtutc(src.c_str(), src.size());
@@ -141,8 +206,9 @@ inline int64_t strtutc(std::string_view src) {
 template <clock_precision Prec>
 inline size_t strflocal(char* dest, int64_t ts) {
     std::time_t t = ts / 1000000000LL;
-    std::tm* local_time = std::localtime(&t);
-    return details::strfepoch<Prec>(dest, local_time, ts);
+    std::tm local_time;
+    localtime_r(&t, &local_time);
+    return details::strfepoch<Prec>(dest, &local_time, ts);
 }
 template <clock_precision Prec>
 inline size_t strflocal(std::string& dest, int64_t ts) {
@@ -205,13 +271,23 @@ inline size_t strflocal(std::string_view dest, char prec = 's') {
     return strflocal(dest.data(), prec);
 }
 /**
- * @description Converts given string int local time to epoch.
+ * @description Converts given string int local time to nanoseconds since
+ * epoch. INVALID_TIMESTAMP if it is malformed.
  * @param src The address of input buffer.
  * @param size The size of input buffer.
  */
 inline int64_t strtlocal(const char* src, int size) {
-    auto f = [](struct tm* t) { return timelocal(t); };
-    return details::strtepoch(src, size, f);
+    details::civil_time t;
+    if (!details::strtcivil(src, size, t)) return INVALID_TIMESTAMP;
+    std::tm dt = {};
+    dt.tm_year = t.year - 1900;
+    dt.tm_mon = t.month - 1;
+    dt.tm_mday = t.day;
+    dt.tm_hour = t.hour;
+    dt.tm_min = t.minute;
+    dt.tm_sec = t.second;
+    dt.tm_isdst = -1;
+    return static_cast<int64_t>(timelocal(&dt)) * 1000000000LL + t.nanos;
 }
 inline int64_t strtlocal(const std::string& src, int size) {
     return strtlocal(src.c_str(), src.size());
@@ -252,77 +328,128 @@ namespace details {
         if constexpr (Prec > clock_precision::seconds) {
             dest[17] = '.';
         }
+        // Most significant group first, lower precisions truncate.
         if constexpr (Prec >= clock_precision::milliseconds) {
-            dest[20] = '0' + nsec % 10; nsec /= 10; size = 21;
-            dest[19] = '0' + nsec % 10; nsec /= 10;
-            dest[18] = '0' + nsec % 10; nsec /= 10;
+            int ms = nsec / 1000000;
+            dest[20] = '0' + ms % 10; ms /= 10; size = 21;
+            dest[19] = '0' + ms % 10; ms /= 10;
+            dest[18] = '0' + ms % 10; ms /= 10;
         }
         if constexpr (Prec >= clock_precision::microseconds) {
-            dest[23] = '0' + nsec % 10; nsec /= 10; size = 24;
-            dest[22] = '0' + nsec % 10; nsec /= 10;
-            dest[21] = '0' + nsec % 10; nsec /= 10;
+            int us = nsec / 1000 % 1000;
+            dest[23] = '0' + us % 10; us /= 10; size = 24;
+            dest[22] = '0' + us % 10; us /= 10;
+            dest[21] = '0' + us % 10; us /= 10;
         }
         if constexpr (Prec >= clock_precision::nanoseconds) {
-            dest[26] = '0' + nsec % 10; nsec /= 10; size = 27;
-            dest[25] = '0' + nsec % 10; nsec /= 10;
-            dest[24] = '0' + nsec % 10; nsec /= 10;
+            int ns = nsec % 1000;
+            dest[26] = '0' + ns % 10; ns /= 10; size = 27;
+            dest[25] = '0' + ns % 10; ns /= 10;
+            dest[24] = '0' + ns % 10; ns /= 10;
         }
         return size;
     }
 
-    template <typename Func>
-    int64_t strtepoch(const char *src, int size, Func&& f)
-    {
-        int year = 0;
-        year = 10 * year + src[0] - '0';
-        year = 10 * year + src[1] - '0';
-        year = 10 * year + src[2] - '0';
-        year = 10 * year + src[3] - '0';
-        int month = 0;
-        month = 10 * month + src[4] - '0';
-        month = 10 * month + src[5] - '0';
-        int day = 0;
-        day = 10 * day + src[6] - '0';
-        day = 10 * day + src[7] - '0';
-        int hour = 0;
-        hour = 10 * hour + src[9] - '0';
-        hour = 10 * hour + src[10] - '0';
-        int minute = 0;
-        minute = 10 * minute + src[12] - '0';
-        minute = 10 * minute + src[13] - '0';
-        int second = 0;
-        second = 10 * second + src[15] - '0';
-        second = 10 * second + src[16] - '0';
+    //! Eight ASCII digits, first digit in the low byte, minus '0'. False if any isn't a digit.
+    inline bool swar_digits(uint64_t word, uint64_t& digits) {
+        digits = word - 0x3030303030303030ULL;
+        // A byte borrowed (below '0') or is above 9.
+        return ((digits | (digits + 0x7676767676767676ULL)) & 0x8080808080808080ULL) == 0;
+    }
+    //! Value of eight decoded digits.
+    inline uint32_t swar_value(uint64_t digits) {
+        digits = (digits * 10 + (digits >> 8)) & 0x00FF00FF00FF00FFULL;
+        digits = (digits * 100 + (digits >> 16)) & 0x0000FFFF0000FFFFULL;
+        return uint32_t((digits * 10000 + (digits >> 32)) & 0xFFFFFFFFULL);
+    }
 
-        std::tm dt = {};
-        dt.tm_year = year - 1900;
-        dt.tm_mon = month - 1;
-        dt.tm_mday = day;
-        dt.tm_hour = hour;
-        dt.tm_min = minute;
-        dt.tm_sec = second;
-        if (size < 20)
-            return static_cast<int64_t>(f(&dt));
-        int ms = 0;
-        int p = 1000;
-        ms = 10 * ms + src[18] - '0';
-        ms = 10 * ms + src[19] - '0';
-        ms = 10 * ms + src[20] - '0';
-        if (size > 23) {
-            p *= 1000;
-            ms = 10 * ms + src[21] - '0';
-            ms = 10 * ms + src[22] - '0';
-            ms = 10 * ms + src[23] - '0';
-        }
-        if (size > 26) {
-            p *= 1000;
-            ms = 10 * ms + src[24] - '0';
-            ms = 10 * ms + src[25] - '0';
-            ms = 10 * ms + src[26] - '0';
+    inline bool strtcivil(const char* src, int size, civil_time& t)
+    {
+        if (size < 17 || size == 18 || size > 27) return false;
+        if (src[8] != '-' || (size > 17 && src[17] != '.')) return false;
+        uint64_t date, time, digits;
+        std::memcpy(&date, src, 8);
+        std::memcpy(&time, src + 9, 8);
+        if ((time & 0x0000FF0000FF0000ULL) != 0x00003A00003A0000ULL) return false;
+        // HH0MM0SS, the colons as zeros, decoded two digits per 16 bit lane.
+        time = (time & ~0x0000FF0000FF0000ULL) | 0x0000300000300000ULL;
+        if (!swar_digits(date, date) || !swar_digits(time, time)) return false;
+        date = (date * 10 + (date >> 8)) & 0x00FF00FF00FF00FFULL;
+        t.year = int(date & 0xFF) * 100 + int((date >> 16) & 0xFF);
+        t.month = int((date >> 32) & 0xFF);
+        t.day = int((date >> 48) & 0xFF);
+        t.hour = (time & 0xFF) * 10 + ((time >> 8) & 0xFF);
+        t.minute = ((time >> 24) & 0xFF) * 10 + ((time >> 32) & 0xFF);
+        t.second = ((time >> 48) & 0xFF) * 10 + ((time >> 56) & 0xFF);
+        static constexpr const int MONTH_DAYS[13] = {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool leap = (t.year % 4 == 0 && t.year % 100 != 0) || t.year % 400 == 0;
+        if (t.month < 1 || t.month > 12 || t.day < 1 || t.day > MONTH_DAYS[t.month]) return false;
+        if (t.month == 2 && t.day == 29 && !leap) return false;
+        // 60 is a leap second.
+        if (t.hour > 23 || t.minute > 59 || t.second > 60) return false;
+        t.nanos = 0;
+        if (size > 17) {
+            // Fraction padded with zeros to 9 digits, 8 through SWAR and the last on its own.
+            char fraction[9] = {'0', '0', '0', '0', '0', '0', '0', '0', '0'};
+            for (int i = 18; i < size; ++i) fraction[i - 18] = src[i];
+            uint64_t word;
+            std::memcpy(&word, fraction, 8);
+            unsigned last = unsigned(fraction[8] - '0');
+            if (!swar_digits(word, digits) || last > 9) return false;
+            t.nanos = int64_t(swar_value(digits)) * 10 + last;
         }
-        return static_cast<int64_t>(f(&dt)) * p + ms;
+        return true;
+    }
+
+    inline int64_t days_from_civil(int year, int month, int day)
+    {
+        // Years start in March so the leap day is the last of the year.
+        year -= month <= 2;
+        int64_t era = (year >= 0 ? year : year - 399) / 400;
+        int64_t yoe = year - era * 400;
+        int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
     }
 }
+
+inline void utc_formatter::render(int64_t second)
+{
+    std::time_t t = second;
+    std::tm gm;
+    gmtime_r(&t, &gm);
+    int year = gm.tm_year + 1900;
+    details::write_2digits(prefix, year / 100);
+    details::write_2digits(prefix + 2, year % 100);
+    details::write_2digits(prefix + 4, gm.tm_mon + 1);
+    details::write_2digits(prefix + 6, gm.tm_mday);
+    prefix[8] = '-';
+    details::write_2digits(prefix + 9, gm.tm_hour);
+    prefix[11] = ':';
+    details::write_2digits(prefix + 12, gm.tm_min);
+    prefix[14] = ':';
+    details::write_2digits(prefix + 15, gm.tm_sec);
+    cachedSecond = second;
+}
+
+template <clock_precision Prec>
+inline size_t utc_formatter::format(char* dest, int64_t ts)
+{
+    // Stamps before the epoch are rare enough to take the slow path.
+    if (ts < 0) return strfutc<Prec>(dest, ts);
+    int64_t second = ts / 1000000000LL;
+    if (second != cachedSecond) render(second);
+    std::memcpy(dest, prefix, sizeof(prefix));
+    if constexpr (Prec == clock_precision::seconds) return 17;
+    unsigned nsec = unsigned(ts - second * 1000000000LL);
+    dest[17] = '.';
+    details::write_3digits(dest + 18, nsec / 1000000);
+    if constexpr (Prec == clock_precision::milliseconds) return 21;
+    details::write_3digits(dest + 21, nsec / 1000 % 1000);
+    if constexpr (Prec == clock_precision::microseconds) return 24;
+    details::write_3digits(dest + 24, nsec % 1000);
+    return 27;
+}
 }
 
 #endif
@@ -0,0 +1,215 @@
+/**
+* @file fixate/fixinstrument.hpp
+* @author Mrityunjay Tripathi
+*
+* Instrument registry, interns Symbol or SecurityID values into dense
+* integer ids so that per instrument state can live in plain arrays.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+#ifndef FIXATE_FIXINSTRUMENT_HPP_
+#define FIXATE_FIXINSTRUMENT_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "fixate/fixtags.hpp"
+
+namespace fixate {
+
+    namespace details {
+
+        //! True if two zero padded 32 byte keys are equal.
+        inline bool equal_key32(const char* a, const char* b)
+        {
+#if defined(__AVX2__)
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+            return _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) == -1;
+#elif defined(__SSE2__)
+            __m128i lo = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+            __m128i hi = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16)));
+            return _mm_movemask_epi8(_mm_and_si128(lo, hi)) == 0xffff;
+#else
+            return std::memcmp(a, b, 32) == 0;
+#endif
+        }
+
+        //! Hash of a zero padded 32 byte key.
+        inline uint32_t hash_key32(const char* key)
+        {
+            uint64_t w[4];
+            std::memcpy(w, key, sizeof(w));
+            uint64_t h = (w[0] * 0x9e3779b97f4a7c15ull) ^ (w[1] * 0xc2b2ae3d27d4eb4full)
+                    ^ (w[2] * 0x165667b19e3779f9ull) ^ (w[3] * 0x27d4eb2f165667c5ull);
+            h ^= h >> 29;
+            return uint32_t(h >> 32);
+        }
+    }
+
+    /**
+     * Maps instrument keys (Symbol or SecurityID values of up to 32 bytes)
+     * to dense ids `0, 1, 2...` in registration order. Lookups are lock
+     * free and can run on any number of threads while one thread at a time
+     * registers new keys. The table is open addressed with linear probing
+     * over 64 bit words holding a hash and the id, keys are compared 32
+     * bytes at a time with SIMD. Capacity is fixed at construction, so the
+     * table never moves under a reader.
+     */
+    class instrument_registry
+    {
+    public:
+        using id_type = uint32_t;
+        static constexpr const id_type npos = UINT32_MAX;
+        static constexpr const size_t KEY_SIZE = 32;
+    public:
+        /**
+         * @param capacity Most instruments which can be registered.
+         * @param keyTag Tag whose value identifies the instrument in raw messages.
+         */
+        explicit instrument_registry(size_t capacity = 4096, const char* keyTag = TagSymbol);
+        instrument_registry(const instrument_registry& other) = delete;
+        instrument_registry& operator=(const instrument_registry& other) = delete;
+
+        //! Id of `key`, registering it if it is new. npos if the key is too long or the registry is full.
+        id_type intern(std::string_view key);
+        //! Id of `key`, npos if it isn't registered.
+        id_type find(std::string_view key) const {
+            alignas(32) char padded[KEY_SIZE];
+            if (!pad(key, padded)) return npos;
+            return find_padded(padded, details::hash_key32(padded));
+        }
+        //! Id of the instrument named by the key tag of a raw message, npos if none.
+        id_type find_in_message(const char* buffer, size_t n) const;
+        //! Id of the `KeyType` field of a parsed message.
+        template <typename KeyType = Symbol, typename TMessage>
+        id_type instrument_id(const TMessage& msg) const {
+            static_assert(TMessage::template has<KeyType>(), "message doesn't carry the instrument key.");
+            return find(msg.template get<KeyType>());
+        }
+        /**
+         * Register every `KeyType` of the `Group` (e.g. `TvpVector<Symbol>`
+         * or a TvpGroup starting with Symbol) of a SecurityList. Returns the
+         * number of entries registered or already known.
+         */
+        template <typename Group, typename KeyType = Symbol, typename TMessage>
+        size_t load(const TMessage& securityList);
+
+        std::string_view name(id_type id) const {
+            const char* key = keys.get() + size_t(id) * KEY_SIZE;
+            return std::string_view(key, strnlen(key, KEY_SIZE));
+        }
+        size_t size() const { return count.load(std::memory_order_acquire); }
+        size_t capacity() const { return limit; }
+    private:
+        static bool pad(std::string_view key, char* padded) {
+            if (key.size() > KEY_SIZE || key.empty()) return false;
+            std::memset(padded, 0, KEY_SIZE);
+            std::memcpy(padded, key.data(), key.size());
+            return true;
+        }
+        id_type find_padded(const char* padded, uint32_t hash) const;
+    private:
+        size_t limit;
+        size_t mask;
+        //! High half the key hash, low half the id plus one, 0 when empty.
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+        //! Zero padded keys indexed by id.
+        std::unique_ptr<char[]> keys;
+        std::atomic<size_t> count{0};
+        std::mutex writer;
+        char pattern[16];
+        size_t patternLen;
+    };
+
+    inline instrument_registry::instrument_registry(size_t capacity, const char* keyTag)
+        : limit(capacity)
+    {
+        size_t size = 16;
+        while (size < 2 * capacity) size <<= 1;
+        mask = size - 1;
+        slots.reset(new std::atomic<uint64_t>[size]);
+        for (size_t i = 0; i < size; ++i) slots[i].store(0, std::memory_order_relaxed);
+        keys.reset(new char[capacity * KEY_SIZE + KEY_SIZE]());
+        patternLen = 0;
+        pattern[patternLen++] = SEPARATOR;
+        size_t tagLen = std::min(strlen(keyTag), sizeof(pattern) - 2);
+        std::memcpy(pattern + patternLen, keyTag, tagLen); patternLen += tagLen;
+        pattern[patternLen++] = '=';
+    }
+
+    inline instrument_registry::id_type instrument_registry::find_padded(const char* padded, uint32_t hash) const
+    {
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            uint64_t slot = slots[i].load(std::memory_order_acquire);
+            if (slot == 0) return npos;
+            if (uint32_t(slot >> 32) == hash) {
+                id_type id = uint32_t(slot) - 1;
+                if (details::equal_key32(keys.get() + size_t(id) * KEY_SIZE, padded)) return id;
+            }
+        }
+    }
+
+    inline instrument_registry::id_type instrument_registry::intern(std::string_view key)
+    {
+        alignas(32) char padded[KEY_SIZE];
+        if (!pad(key, padded)) return npos;
+        uint32_t hash = details::hash_key32(padded);
+        id_type id = find_padded(padded, hash);
+        if (id != npos) return id;
+        std::lock_guard<std::mutex> guard(writer);
+        // Another writer may have registered it meanwhile.
+        id = find_padded(padded, hash);
+        if (id != npos) return id;
+        size_t next = count.load(std::memory_order_relaxed);
+        if (next >= limit) return npos;
+        std::memcpy(keys.get() + next * KEY_SIZE, padded, KEY_SIZE);
+        size_t i = hash & mask;
+        while (slots[i].load(std::memory_order_relaxed) != 0) i = (i + 1) & mask;
+        // The key is written before the slot is published.
+        slots[i].store(uint64_t(hash) << 32 | (next + 1), std::memory_order_release);
+        count.store(next + 1, std::memory_order_release);
+        return id_type(next);
+    }
+
+    inline instrument_registry::id_type instrument_registry::find_in_message(const char* buffer, size_t n) const
+    {
+        std::string_view msg(buffer, n);
+        size_t pos = msg.find(std::string_view(pattern, patternLen));
+        if (pos == std::string_view::npos) return npos;
+        pos += patternLen;
+        size_t end = msg.find(SEPARATOR, pos);
+        if (end == std::string_view::npos) return npos;
+        return find(msg.substr(pos, end - pos));
+    }
+
+    template <typename Group, typename KeyType, typename TMessage>
+    inline size_t instrument_registry::load(const TMessage& securityList)
+    {
+        size_t loaded = 0;
+        int64_t n = securityList.template get<NoRelatedSym>();
+        for (int64_t i = 0; i < n; ++i) {
+            std::string_view key;
+            if constexpr (std::is_same_v<Group, TvpVector<KeyType>>) key = securityList.template get<Group>(i);
+            else key = securityList.template get<Group, KeyType>(i);
+            loaded += intern(key) != npos;
+        }
+        return loaded;
+    }
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+/**
+* @file fixate/fixmemory.hpp
+* @author Mrityunjay Tripathi
+*
+* Memory placement policy for buffers and pools, backing pages (4 KB,
+* transparent or explicit huge pages), NUMA binding and pre-faulting.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+
+#ifndef FIXATE_FIXMEMORY_HPP_
+#define FIXATE_FIXMEMORY_HPP_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <system_error>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace fixate {
+
+    /**
+     * Pages backing a region. `transparent` asks for transparent huge pages
+     * with madvise, `huge_2mb` and `huge_1gb` need pages reserved in the
+     * hugetlbfs pool (e.g. `vm.nr_hugepages`).
+     */
+    enum class page_size : int { normal = 0, transparent = 1, huge_2mb = 2, huge_1gb = 3 };
+
+    struct memory_policy {
+        page_size pages = page_size::normal;
+        //! NUMA node to bind the memory to, -1 leaves placement to first touch.
+        int numa_node = -1;
+        //! Touch every page up front instead of faulting on the hot path.
+        bool prefault = false;
+        //! Degrade to smaller pages and ignore binding errors instead of throwing.
+        bool fallback = true;
+    };
+
+    namespace details {
+
+        inline size_t page_bytes(page_size pages) {
+            switch (pages) {
+            case page_size::huge_2mb: return size_t(1) << 21;
+            case page_size::huge_1gb: return size_t(1) << 30;
+            default: return sysconf(_SC_PAGESIZE);
+            }
+        }
+
+        inline int page_shift(page_size pages) { return pages == page_size::huge_1gb ? 30 : 21; }
+
+        inline bool is_hugetlb(page_size pages) {
+            return pages == page_size::huge_2mb || pages == page_size::huge_1gb;
+        }
+
+        inline page_size smaller_pages(page_size pages) {
+            return pages == page_size::huge_1gb ? page_size::huge_2mb : page_size::transparent;
+        }
+
+        inline size_t round_up(size_t size, size_t to) { return (size + to - 1) / to * to; }
+
+        //! Bind `[addr, addr + size)` to `node` with mbind(2) and MPOL_BIND.
+        inline int bind_numa(void* addr, size_t size, int node)
+        {
+            if (node < 0) return 0;
+            constexpr int MPOL_BIND_MODE = 2;
+            constexpr unsigned MPOL_MF_MOVE_FLAG = 1 << 1;
+            unsigned long mask[4] = {};
+            if (node >= int(sizeof(mask) * 8)) { errno = EINVAL; return -1; }
+            mask[node / 64] = 1ul << (node % 64);
+            return syscall(SYS_mbind, addr, size, MPOL_BIND_MODE, mask, sizeof(mask) * 8, MPOL_MF_MOVE_FLAG);
+        }
+
+        //! Fault every page in, without changing its contents.
+        inline void prefault(void* addr, size_t size)
+        {
+            size_t step = sysconf(_SC_PAGESIZE);
+            volatile char* p = static_cast<volatile char*>(addr);
+            for (size_t i = 0; i < size; i += step) p[i] = p[i];
+        }
+
+        /**
+         * Apply the THP, NUMA and prefault parts of `policy` to a mapping,
+         * returns an errno value if binding failed and fallback is off.
+         */
+        inline int apply_policy(void* addr, size_t size, page_size pages, const memory_policy& policy)
+        {
+            if (pages == page_size::transparent) madvise(addr, size, MADV_HUGEPAGE);
+            if (bind_numa(addr, size, policy.numa_node) != 0 && !policy.fallback) return errno;
+            if (policy.prefault) prefault(addr, size);
+            return 0;
+        }
+
+        //! Reserve `size` bytes of address space aligned to `alignment`.
+        inline char* reserve_aligned(size_t size, size_t alignment)
+        {
+            void* p = mmap(nullptr, size + alignment, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p == MAP_FAILED) return nullptr;
+            uintptr_t raw = reinterpret_cast<uintptr_t>(p);
+            uintptr_t aligned = round_up(raw, alignment);
+            if (aligned > raw) munmap(p, aligned - raw);
+            if (raw + alignment > aligned) munmap(reinterpret_cast<void*>(aligned + size), raw + alignment - aligned);
+            return reinterpret_cast<char*>(aligned);
+        }
+    }
+
+    /**
+     * Anonymous memory allocated under a `memory_policy`. When the requested
+     * pages are unavailable and the policy allows fallback, smaller pages are
+     * used, `pages()` reports what backs the region.
+     */
+    class memory_region
+    {
+    public:
+        memory_region() {}
+        memory_region(size_t size, const memory_policy& policy = memory_policy());
+        memory_region(const memory_region& other) = delete;
+        memory_region& operator=(const memory_region& other) = delete;
+        memory_region(memory_region&& other) { *this = std::move(other); }
+        memory_region& operator=(memory_region&& other) {
+            if (this != &other) {
+                release();
+                ptr = other.ptr; other.ptr = nullptr;
+                len = other.len; other.len = 0;
+                backing = other.backing;
+            }
+            return *this;
+        }
+        ~memory_region() { release(); }
+        void* data() const { return ptr; }
+        size_t size() const { return len; }
+        page_size pages() const { return backing; }
+    private:
+        void release() {
+            if (ptr) munmap(ptr, len);
+            ptr = nullptr;
+        }
+    private:
+        void* ptr = nullptr;
+        size_t len = 0;
+        page_size backing = page_size::normal;
+    };
+
+    inline memory_region::memory_region(size_t size, const memory_policy& policy)
+    {
+        backing = policy.pages;
+        while (true) {
+            if (details::is_hugetlb(backing)) {
+                len = details::round_up(size, details::page_bytes(backing));
+                int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (details::page_shift(backing) << MAP_HUGE_SHIFT);
+                void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE, flags, -1, 0);
+                if (p != MAP_FAILED) { ptr = p; break; }
+                if (!policy.fallback) throw std::system_error(errno, std::generic_category(), "mmap(MAP_HUGETLB)");
+                backing = details::smaller_pages(backing);
+                continue;
+            }
+            // Transparent huge pages only back 2 MB aligned ranges.
+            size_t align = backing == page_size::transparent ? details::page_bytes(page_size::huge_2mb) : details::page_bytes(backing);
+            len = details::round_up(size, align);
+            char* p = details::reserve_aligned(len, align);
+            if (p == nullptr) throw std::system_error(errno, std::generic_category(), "mmap");
+            if (mmap(p, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) {
+                int ec = errno;
+                munmap(p, len);
+                throw std::system_error(ec, std::generic_category(), "mmap");
+            }
+            ptr = p;
+            break;
+        }
+        int ec = details::apply_policy(ptr, len, backing, policy);
+        if (ec != 0) {
+            release();
+            throw std::system_error(ec, std::generic_category(), "mbind");
+        }
+    }
+
+}
+
+#endif
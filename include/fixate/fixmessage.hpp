@@ -41,18 +41,27 @@ namespace fixate {
     template <typename Target, typename First, typename ... Rest>
     constexpr bool IsLeaderV = IsLeader<Target, First, Rest...>::value;
 
+    //! `MessageType` itself, or a `TvpConstant` of its tag.
+    template <typename T, typename = void>
+    struct IsMessageTypeTvp : std::is_same<T, MessageType> {};
+    template <typename T>
+    struct IsMessageTypeTvp<T, std::void_t<decltype(T::tag_reference)>>
+        : std::bool_constant<T::tag_reference == &TagMessageType> {};
+
     template <FixVersionType FixVersion, typename ... TvpTypes>
-    class FixMessage
+    class FIXATE_MESSAGE_ALIGNAS FixMessage
     {
         static_assert(
             CheckUniqueV<FixVersionTag<FixVersion>, BodyLength, TvpTypes..., CheckSum>,
             "Tag-Value Pair must be unique in message."
         );
         static_assert(
-            IsLeaderV<MessageType, TvpTypes...>,
-            "The FIX Message body must start with `MessageType`."
+            IsMessageTypeTvp<typename LeaderTvpType<typename FirstOf<TvpTypes...>::type>::type>::value,
+            "The FIX Message body must start with `MessageType`, or a constant of it."
         );
     public:
+        using Body = TvpGroup<TvpTypes ...>;
+
         FixMessage() : mBodyLen(0) {}
 
         template <typename TvpType, typename ... TArgs, typename ... Args>
@@ -64,6 +73,16 @@ namespace fixate {
         template <typename TvpType, typename ... TArgs, typename ... Args>
         void set(Args&& ... args) { return mMsgBody.template set<TvpType, TArgs...>(std::forward<Args>(args)...); }
 
+        //! Whether `TvpType` is a field of the message body.
+        template <typename TvpType>
+        static constexpr bool has() { return (std::is_same_v<TvpType, TvpTypes> || ...); }
+
+        //! The field itself, e.g. a group container to reach its columns.
+        template <typename TvpType>
+        const TvpType& field() const { return mMsgBody.template field<TvpType>(); }
+        template <typename TvpType>
+        TvpType& field() { return mMsgBody.template field<TvpType>(); }
+
         int getBodyLength() { return mBodyLen; }
 
         int updateBodyLength() {
@@ -86,6 +105,46 @@ namespace fixate {
             return bW;
         }
 
+        /**
+         * `dump(buffer, true, true)` in one walk over the fields. The body is
+         * rendered once, `HeaderCapacity` bytes into `buffer`, the header with
+         * the now known BodyLength is right-aligned in front of it, and the
+         * checksum is taken from the rendered bytes while they are still in
+         * cache. The message starts within the first `HeaderCapacity` bytes
+         * of `buffer`, not necessarily at it.
+         */
+        std::string_view encode(char* buffer) {
+            char* body = buffer + HeaderCapacity;
+            mBodyLen = mMsgBody.dump(body);
+            mMsgHeader.template set<BodyLength>(mBodyLen);
+            char* first = body - mMsgHeader.width();
+            int bW = body - first + mBodyLen;
+            mMsgHeader.dump(first);
+            mMsgTrailer.set<CheckSum>(details::byte_sum(first, bW));
+            bW += mMsgTrailer.dump(first + bW);
+            return std::string_view(first, bW);
+        }
+
+        /**
+         * The message as `iovec`s, see `iov_writer`. BodyLength and CheckSum
+         * are always set, from the bytes as the body is written, and the
+         * header is rendered last into room kept for it in front of the body.
+         * Returns the length of the message.
+         */
+        int dump_iov(iov_writer& w) {
+            char* body = w.reserve(HeaderCapacity);
+            mMsgBody.dump_iov(w);
+            w.flush();
+            mBodyLen = w.bytes();
+            mMsgHeader.template set<BodyLength>(mBodyLen);
+            int hW = mMsgHeader.width();
+            w.prepend(body - hW, mMsgHeader.dump(body - hW));
+            mMsgTrailer.set<CheckSum>(w.sum());
+            w.write(mMsgTrailer);
+            w.flush();
+            return w.bytes();
+        }
+
         int parse(const char* src) {
             int bR = mMsgHeader.parse(src);
             bR += mMsgBody.parse(src + bR);
@@ -93,9 +152,27 @@ namespace fixate {
             return bR;
         }
 
+        /**
+         * Parse the body through `Parser::parse_body(Body&, TvpParseData&)`
+         * rather than field by field in declaration order, e.g. the tag
+         * switch `tools/fixgen.py` emits, which takes fields in any order
+         * and steps over unknown ones. It must stop at the CheckSum.
+         */
+        template <typename Parser>
+        int parse(const char* src) {
+            int bR = mMsgHeader.parse(src);
+            TvpParseData pd(src + bR, -1);
+            bR += Parser::parse_body(mMsgBody, pd);
+            bR += mMsgTrailer.parse(src + bR);
+            return bR;
+        }
+
+        //! Widest BeginString and BodyLength, the room `encode` and `dump_iov` keep for the header.
+        static constexpr const int HeaderCapacity =
+            FixVersionTag<FixVersion>::type::bytes.size() + BodyLength::TagSize + BodyLength::ValueSize + 2;
     private:
         TvpGroup<typename FixVersionTag<FixVersion>::type, BodyLength> mMsgHeader;
-        TvpGroup<TvpTypes ...> mMsgBody;
+        Body mMsgBody;
         TvpGroup<CheckSum> mMsgTrailer;
         int mBodyLen;
     };
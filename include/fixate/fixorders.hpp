@@ -0,0 +1,342 @@
+/**
+* @file fixate/fixorders.hpp
+* @author Mrityunjay Tripathi
+*
+* Order state store for order entry sessions, live orders are looked up by
+* ClOrdID or OrderID and updated from ExecutionReport and OrderCancelReject
+* messages without allocating.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+#ifndef FIXATE_FIXORDERS_HPP_
+#define FIXATE_FIXORDERS_HPP_
+
+#include "fixate/fixate.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace fixate {
+
+    /**
+     * Values of ExecType (150) and OrdStatus (39) the store acts on.
+     */
+    enum class ExecTypeEnum : char {
+        New = '0', DoneForDay = '3', Canceled = '4', Replaced = '5', PendingCancel = '6', Rejected = '8',
+        PendingNew = 'A', Expired = 'C', PendingReplace = 'E', Trade = 'F'
+    };
+    enum class OrdStatusEnum : char {
+        New = '0', PartiallyFilled = '1', Filled = '2', DoneForDay = '3', Canceled = '4', Replaced = '5',
+        PendingCancel = '6', Rejected = '8', PendingNew = 'A', Expired = 'C', PendingReplace = 'E'
+    };
+
+    //! State of one order, a cache line.
+    struct alignas(64) OrderRecord
+    {
+        double orderQty;
+        double price;
+        double cumQty;
+        double leavesQty;
+        double avgPx;
+        //! Free for the application, e.g. an instrument_registry id.
+        uint32_t instrument;
+        //! While a replace is pending, the index of the order it replaces.
+        uint32_t replaces;
+        //! While a replace is pending, the index of the replacement.
+        uint32_t replacedBy;
+        char side;
+        char ordType;
+        char ordStatus;
+        char execType;
+        bool hasOrderID;
+    };
+    static_assert(sizeof(OrderRecord) == 64, "OrderRecord must fill one cache line.");
+
+    /**
+     * Live orders of a session in preallocated storage. Records are found
+     * by ClOrdID, or by OrderID once the counterparty has assigned one,
+     * through two open addressing tables with linear probing and backward
+     * shift deletion. Keys are ClOrdID/OrderID bytes zero padded to 32.
+     * Orders reaching a terminal status are removed, a removed record stays
+     * readable until the next `add`. A pending replacement and the order it
+     * replaces link to each other, removing either one unlinks the other.
+     * Not thread safe.
+     */
+    class OrderStore
+    {
+    public:
+        using index_type = uint32_t;
+        static constexpr const index_type npos = UINT32_MAX;
+        static constexpr const size_t KEY_SIZE = 32;
+    public:
+        explicit OrderStore(size_t capacity, const memory_policy& policy = memory_policy());
+        OrderStore(const OrderStore& other) = delete;
+        OrderStore& operator=(const OrderStore& other) = delete;
+
+        size_t size() const { return count; }
+        size_t capacity() const { return limit; }
+        OrderRecord& operator[](index_type i) { return records[i]; }
+        const OrderRecord& operator[](index_type i) const { return records[i]; }
+        index_type indexOf(const OrderRecord* record) const { return index_type(record - records); }
+        std::string_view clOrdID(index_type i) const { return key(clOrdIDs, i); }
+        std::string_view orderID(index_type i) const { return records[i].hasOrderID ? key(orderIDs, i) : std::string_view(); }
+
+        //! New record for `clOrdID`, nullptr if the id is in use, too long or the store is full.
+        OrderRecord* add(std::string_view clOrdID);
+        OrderRecord* find(std::string_view clOrdID) { return at(byClOrdID.find(clOrdIDs, clOrdID)); }
+        OrderRecord* findByOrderID(std::string_view orderID) { return at(byOrderID.find(orderIDs, orderID)); }
+        void remove(OrderRecord* record);
+
+        //! Track a NewOrderSingle being sent, PendingNew until acknowledged.
+        template <typename TMessage>
+        OrderRecord* onNewOrder(const TMessage& msg);
+        /**
+         * Track an OrderCancelReplaceRequest being sent, the replacement is
+         * a new record linked to the order named by OrigClOrdID until the
+         * counterparty accepts or rejects it. nullptr if that order is
+         * unknown or already has a replace pending.
+         */
+        template <typename TMessage>
+        OrderRecord* onReplaceRequest(const TMessage& msg);
+        /**
+         * Apply an ExecutionReport, updating OrdStatus, ExecType, CumQty,
+         * LeavesQty and AvgPx of the order (looked up by ClOrdID, then
+         * OrigClOrdID, then OrderID). Returns the order, nullptr if unknown.
+         */
+        template <typename TMessage>
+        OrderRecord* onExecutionReport(const TMessage& msg);
+        /**
+         * Apply an OrderCancelReject, a rejected replacement is dropped and
+         * the order it replaces returned. An order the reject reports in a
+         * terminal OrdStatus, e.g. a replacement whose original filled in
+         * the meantime, is removed.
+         */
+        template <typename TMessage>
+        OrderRecord* onCancelReject(const TMessage& msg);
+    private:
+        /**
+         * Slots hold the key hash in the high half and the record index plus
+         * one in the low half, 0 marks an empty slot.
+         */
+        struct KeyTable
+        {
+            uint64_t* slots = nullptr;
+            size_t mask = 0;
+            index_type find(const char* keys, std::string_view key) const;
+            void insert(const char* keys, index_type index);
+            void erase(const char* keys, index_type index);
+            size_t home(uint32_t hash) const { return hash & mask; }
+        };
+        static bool pad(std::string_view key, char* padded) {
+            if (key.size() > KEY_SIZE || key.empty()) return false;
+            std::memset(padded, 0, KEY_SIZE);
+            std::memcpy(padded, key.data(), key.size());
+            return true;
+        }
+        static std::string_view key(const char* keys, index_type i) {
+            const char* k = keys + size_t(i) * KEY_SIZE;
+            return std::string_view(k, strnlen(k, KEY_SIZE));
+        }
+        OrderRecord* at(index_type i) { return i == npos ? nullptr : &records[i]; }
+        void setOrderID(index_type i, std::string_view orderID);
+        static bool terminal(char ordStatus) {
+            return ordStatus == char(OrdStatusEnum::Filled) || ordStatus == char(OrdStatusEnum::Canceled)
+                || ordStatus == char(OrdStatusEnum::Rejected) || ordStatus == char(OrdStatusEnum::Expired)
+                || ordStatus == char(OrdStatusEnum::DoneForDay);
+        }
+    private:
+        memory_region region;
+        OrderRecord* records = nullptr;
+        char* clOrdIDs = nullptr;
+        char* orderIDs = nullptr;
+        index_type* freeList = nullptr;
+        KeyTable byClOrdID;
+        KeyTable byOrderID;
+        size_t limit = 0;
+        size_t count = 0;
+    };
+
+    inline OrderStore::OrderStore(size_t capacity, const memory_policy& policy)
+        : limit(capacity)
+    {
+        size_t slotCount = 16;
+        while (slotCount < 2 * capacity) slotCount <<= 1;
+        size_t recordBytes = capacity * sizeof(OrderRecord);
+        size_t keyBytes = capacity * KEY_SIZE;
+        size_t slotBytes = slotCount * sizeof(uint64_t);
+        size_t freeBytes = capacity * sizeof(index_type);
+        region = memory_region(recordBytes + 2 * keyBytes + 2 * slotBytes + freeBytes, policy);
+        // Anonymous memory comes zeroed, every slot starts empty.
+        char* p = static_cast<char*>(region.data());
+        records = reinterpret_cast<OrderRecord*>(p); p += recordBytes;
+        clOrdIDs = p; p += keyBytes;
+        orderIDs = p; p += keyBytes;
+        byClOrdID.slots = reinterpret_cast<uint64_t*>(p); p += slotBytes;
+        byOrderID.slots = reinterpret_cast<uint64_t*>(p); p += slotBytes;
+        byClOrdID.mask = byOrderID.mask = slotCount - 1;
+        freeList = reinterpret_cast<index_type*>(p);
+        // Hand out low indices first.
+        for (size_t i = 0; i < capacity; ++i) freeList[i] = index_type(capacity - 1 - i);
+    }
+
+    inline OrderStore::index_type OrderStore::KeyTable::find(const char* keys, std::string_view key) const
+    {
+        alignas(32) char padded[KEY_SIZE];
+        if (!pad(key, padded)) return npos;
+        uint32_t hash = details::hash_key32(padded);
+        for (size_t i = home(hash); ; i = (i + 1) & mask) {
+            uint64_t slot = slots[i];
+            if (slot == 0) return npos;
+            if (uint32_t(slot >> 32) == hash) {
+                index_type index = uint32_t(slot) - 1;
+                if (details::equal_key32(keys + size_t(index) * KEY_SIZE, padded)) return index;
+            }
+        }
+    }
+
+    inline void OrderStore::KeyTable::insert(const char* keys, index_type index)
+    {
+        uint32_t hash = details::hash_key32(keys + size_t(index) * KEY_SIZE);
+        size_t i = home(hash);
+        while (slots[i] != 0) i = (i + 1) & mask;
+        slots[i] = uint64_t(hash) << 32 | (index + 1);
+    }
+
+    inline void OrderStore::KeyTable::erase(const char* keys, index_type index)
+    {
+        uint32_t hash = details::hash_key32(keys + size_t(index) * KEY_SIZE);
+        size_t i = home(hash);
+        while (uint32_t(slots[i]) != index + 1) {
+            if (slots[i] == 0) return;
+            i = (i + 1) & mask;
+        }
+        // Shift later members of the probe run back into the hole.
+        for (size_t j = (i + 1) & mask; slots[j] != 0; j = (j + 1) & mask) {
+            size_t h = home(uint32_t(slots[j] >> 32));
+            bool movable = i <= j ? (h <= i || h > j) : (h <= i && h > j);
+            if (movable) { slots[i] = slots[j]; i = j; }
+        }
+        slots[i] = 0;
+    }
+
+    inline OrderRecord* OrderStore::add(std::string_view clOrdID)
+    {
+        if (count == limit || byClOrdID.find(clOrdIDs, clOrdID) != npos) return nullptr;
+        index_type i = freeList[limit - 1 - count];
+        if (!pad(clOrdID, clOrdIDs + size_t(i) * KEY_SIZE)) return nullptr;
+        count++;
+        byClOrdID.insert(clOrdIDs, i);
+        OrderRecord& r = records[i];
+        r = OrderRecord{};
+        r.instrument = npos;
+        r.replaces = npos;
+        r.replacedBy = npos;
+        return &r;
+    }
+
+    inline void OrderStore::remove(OrderRecord* record)
+    {
+        index_type i = indexOf(record);
+        if (record->replaces != npos) records[record->replaces].replacedBy = npos;
+        if (record->replacedBy != npos) records[record->replacedBy].replaces = npos;
+        record->replaces = record->replacedBy = npos;
+        byClOrdID.erase(clOrdIDs, i);
+        if (record->hasOrderID) byOrderID.erase(orderIDs, i);
+        record->hasOrderID = false;
+        freeList[limit - count] = i;
+        count--;
+    }
+
+    inline void OrderStore::setOrderID(index_type i, std::string_view orderID)
+    {
+        if (records[i].hasOrderID || !pad(orderID, orderIDs + size_t(i) * KEY_SIZE)) return;
+        records[i].hasOrderID = true;
+        byOrderID.insert(orderIDs, i);
+    }
+
+    template <typename TMessage>
+    inline OrderRecord* OrderStore::onNewOrder(const TMessage& msg)
+    {
+        OrderRecord* r = add(msg.template get<ClOrdID>());
+        if (r == nullptr) return nullptr;
+        r->orderQty = msg.template get<OrderQty>();
+        r->leavesQty = r->orderQty;
+        if constexpr (TMessage::template has<Price>()) r->price = msg.template get<Price>();
+        if constexpr (TMessage::template has<Side>()) r->side = msg.template get<Side>();
+        if constexpr (TMessage::template has<OrderType>()) r->ordType = msg.template get<OrderType>();
+        r->ordStatus = char(OrdStatusEnum::PendingNew);
+        return r;
+    }
+
+    template <typename TMessage>
+    inline OrderRecord* OrderStore::onReplaceRequest(const TMessage& msg)
+    {
+        OrderRecord* orig = find(msg.template get<OrigClOrdID>());
+        if (orig == nullptr || orig->replacedBy != npos) return nullptr;
+        OrderRecord* r = add(msg.template get<ClOrdID>());
+        if (r == nullptr) return nullptr;
+        *r = *orig;
+        r->hasOrderID = false;
+        r->replaces = indexOf(orig);
+        orig->replacedBy = indexOf(r);
+        r->ordStatus = char(OrdStatusEnum::PendingReplace);
+        if constexpr (TMessage::template has<OrderQty>()) r->orderQty = msg.template get<OrderQty>();
+        if constexpr (TMessage::template has<Price>()) r->price = msg.template get<Price>();
+        return r;
+    }
+
+    template <typename TMessage>
+    inline OrderRecord* OrderStore::onExecutionReport(const TMessage& msg)
+    {
+        OrderRecord* r = find(msg.template get<ClOrdID>());
+        if constexpr (TMessage::template has<OrigClOrdID>()) {
+            if (r == nullptr) r = find(msg.template get<OrigClOrdID>());
+        }
+        if constexpr (TMessage::template has<OrderID>()) {
+            if (r == nullptr) r = findByOrderID(msg.template get<OrderID>());
+        }
+        if (r == nullptr) return nullptr;
+        if constexpr (TMessage::template has<ExecType>()) r->execType = msg.template get<ExecType>();
+        if constexpr (TMessage::template has<OrderStatus>()) r->ordStatus = msg.template get<OrderStatus>();
+        if constexpr (TMessage::template has<CumQty>()) r->cumQty = msg.template get<CumQty>();
+        if constexpr (TMessage::template has<LeavesQty>()) r->leavesQty = msg.template get<LeavesQty>();
+        if constexpr (TMessage::template has<AvgPx>()) r->avgPx = msg.template get<AvgPx>();
+        if (r->execType == char(ExecTypeEnum::Replaced) && r->replaces != npos) {
+            // The replacement takes over, the original order is done.
+            remove(&records[r->replaces]);
+        }
+        // A pending replacement shares the OrderID of the order it replaces.
+        if constexpr (TMessage::template has<OrderID>()) {
+            if (r->replaces == npos) setOrderID(indexOf(r), msg.template get<OrderID>());
+        }
+        if (terminal(r->ordStatus)) remove(r);
+        return r;
+    }
+
+    template <typename TMessage>
+    inline OrderRecord* OrderStore::onCancelReject(const TMessage& msg)
+    {
+        OrderRecord* r = find(msg.template get<ClOrdID>());
+        if (r == nullptr) return nullptr;
+        if (r->replaces != npos) {
+            OrderRecord* orig = &records[r->replaces];
+            if constexpr (TMessage::template has<OrderStatus>()) orig->ordStatus = msg.template get<OrderStatus>();
+            remove(r);
+            if (terminal(orig->ordStatus)) remove(orig);
+            return orig;
+        }
+        if constexpr (TMessage::template has<OrderStatus>()) r->ordStatus = msg.template get<OrderStatus>();
+        // E.g. too late to cancel or replace, OrdStatus tells the order is done.
+        if (terminal(r->ordStatus)) remove(r);
+        return r;
+    }
+
+}
+
+#endif
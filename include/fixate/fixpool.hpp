@@ -0,0 +1,193 @@
+/**
+* @file fixate/fixpool.hpp
+* @author Mrityunjay Tripathi
+*
+* Allocation without the heap on the hot path, a monotonic arena for group
+* storage and a lock-free pool of preconstructed objects such as messages.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+
+#ifndef FIXATE_FIXPOOL_HPP_
+#define FIXATE_FIXPOOL_HPP_
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "fixate/fixmemory.hpp"
+
+namespace fixate {
+
+    /**
+     * Monotonic allocator over blocks of `block_size` bytes. Deallocation is
+     * a no-op, `reset` hands all the memory out again, so it must only be
+     * called once nothing allocated from the arena is in use. New blocks are
+     * only mapped while the arena grows past its high-water mark.
+     */
+    class arena
+    {
+    public:
+        static constexpr const size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+    public:
+        explicit arena(size_t block_size = DEFAULT_BLOCK_SIZE, const memory_policy& policy = memory_policy())
+            : block_size(block_size), policy(policy) {}
+        arena(const arena& other) = delete;
+        arena& operator=(const arena& other) = delete;
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+            uintptr_t p = details::round_up(cursor, alignment);
+            if (p + size > limit) return grow(size, alignment);
+            cursor = p + size;
+            return reinterpret_cast<void*>(p);
+        }
+        void reset() {
+            current = 0;
+            if (blocks.empty()) { cursor = limit = 0; return; }
+            cursor = reinterpret_cast<uintptr_t>(blocks[0].data());
+            limit = cursor + blocks[0].size();
+        }
+        //! Bytes mapped by the arena.
+        size_t capacity() const {
+            size_t c = 0; for (const auto& b : blocks) c += b.size(); return c;
+        }
+        //! Arena used by default constructed `arena_allocator`s of this thread.
+        static arena& thread_default() {
+            static thread_local arena a;
+            return a;
+        }
+    private:
+        void* grow(size_t size, size_t alignment) {
+            // Reuse the blocks kept by `reset` before mapping a new one.
+            while (++current < blocks.size()) {
+                cursor = reinterpret_cast<uintptr_t>(blocks[current].data());
+                limit = cursor + blocks[current].size();
+                uintptr_t p = details::round_up(cursor, alignment);
+                if (p + size <= limit) { cursor = p + size; return reinterpret_cast<void*>(p); }
+            }
+            blocks.emplace_back(std::max(block_size, size + alignment), policy);
+            current = blocks.size() - 1;
+            cursor = reinterpret_cast<uintptr_t>(blocks.back().data());
+            limit = cursor + blocks.back().size();
+            return allocate(size, alignment);
+        }
+    private:
+        size_t block_size;
+        memory_policy policy;
+        std::vector<memory_region> blocks;
+        size_t current = 0;
+        uintptr_t cursor = 0;
+        uintptr_t limit = 0;
+    };
+
+    /**
+     * Standard allocator drawing from an `arena`, e.g. for
+     * `TvpVector<Group, arena_allocator<Group>>`.
+     */
+    template <typename T>
+    struct arena_allocator
+    {
+        using value_type = T;
+        arena* source;
+        arena_allocator() : source(&arena::thread_default()) {}
+        explicit arena_allocator(arena& a) : source(&a) {}
+        template <typename U>
+        arena_allocator(const arena_allocator<U>& other) : source(other.source) {}
+        T* allocate(size_t n) { return static_cast<T*>(source->allocate(n * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) {}
+        template <typename U>
+        bool operator==(const arena_allocator<U>& other) const { return source == other.source; }
+        template <typename U>
+        bool operator!=(const arena_allocator<U>& other) const { return source != other.source; }
+    };
+
+    /**
+     * Fixed number of `T` constructed up front, checked out and returned from
+     * any thread. The free list is a Treiber stack of slot indices, the head
+     * carries a tag which is bumped on every update to rule out ABA.
+     */
+    template <typename T>
+    class object_pool
+    {
+    public:
+        struct deleter {
+            object_pool* pool;
+            void operator()(T* object) const { pool->release(object); }
+        };
+        using handle = std::unique_ptr<T, deleter>;
+    public:
+        explicit object_pool(size_t capacity, const memory_policy& policy = memory_policy());
+        object_pool(const object_pool& other) = delete;
+        object_pool& operator=(const object_pool& other) = delete;
+        ~object_pool();
+        //! An object, or nullptr when all of them are checked out.
+        T* acquire();
+        void release(T* object);
+        handle checkout() { return handle(acquire(), deleter{this}); }
+        size_t capacity() const { return count; }
+    private:
+        static constexpr const uint32_t EMPTY = UINT32_MAX;
+        static uint64_t pack(uint64_t tag, uint32_t index) { return tag << 32 | index; }
+    private:
+        memory_region region;
+        T* objects = nullptr;
+        std::atomic<uint32_t>* next = nullptr;
+        size_t count = 0;
+        alignas(64) std::atomic<uint64_t> head{0};
+    };
+
+    template <typename T>
+    inline object_pool<T>::object_pool(size_t capacity, const memory_policy& policy)
+        : count(capacity)
+    {
+        size_t links = details::round_up(capacity * sizeof(std::atomic<uint32_t>), alignof(T));
+        region = memory_region(links + capacity * sizeof(T), policy);
+        next = reinterpret_cast<std::atomic<uint32_t>*>(region.data());
+        objects = reinterpret_cast<T*>(static_cast<char*>(region.data()) + links);
+        for (size_t i = 0; i < capacity; ++i) {
+            new (&next[i]) std::atomic<uint32_t>(i + 1 < capacity ? uint32_t(i + 1) : EMPTY);
+            new (&objects[i]) T();
+        }
+        head.store(pack(0, capacity ? 0 : EMPTY), std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    inline object_pool<T>::~object_pool() {
+        for (size_t i = 0; i < count; ++i) objects[i].~T();
+    }
+
+    template <typename T>
+    inline T* object_pool<T>::acquire()
+    {
+        uint64_t old = head.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t index = uint32_t(old);
+            if (index == EMPTY) return nullptr;
+            uint64_t desired = pack((old >> 32) + 1, next[index].load(std::memory_order_relaxed));
+            if (head.compare_exchange_weak(old, desired, std::memory_order_acquire, std::memory_order_acquire))
+                return &objects[index];
+        }
+    }
+
+    template <typename T>
+    inline void object_pool<T>::release(T* object)
+    {
+        if (object == nullptr) return;
+        uint32_t index = uint32_t(object - objects);
+        uint64_t old = head.load(std::memory_order_relaxed);
+        while (true) {
+            next[index].store(uint32_t(old), std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack((old >> 32) + 1, index), std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+}
+
+#endif
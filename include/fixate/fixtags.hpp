@@ -80,6 +80,7 @@ namespace fixate {
     static constexpr const char* TagHeartBtInt = "108";
     static constexpr const char* TagTestReqId = "112";
     static constexpr const char* TagQuoteID = "117";
+    static constexpr const char* TagOrigSendingTime = "122";
     static constexpr const char* TagQuoteReqID = "131";
     static constexpr const char* TagBidPx = "132";
     static constexpr const char* TagOfferPx = "133";
@@ -141,6 +142,14 @@ namespace fixate {
     static constexpr const char* TagNoCollInquiryQualifier = "938";
     static constexpr const char* TagNoCompIDs = "936";
     static constexpr const char* TagNoFills = "1362";
+
+    // BeginString values.
+    static constexpr const char* BeginString_4_0 = "FIX.4.0";
+    static constexpr const char* BeginString_4_1 = "FIX.4.1";
+    static constexpr const char* BeginString_4_2 = "FIX.4.2";
+    static constexpr const char* BeginString_4_3 = "FIX.4.3";
+    static constexpr const char* BeginString_4_4 = "FIX.4.4";
+    static constexpr const char* BeginString_5_0 = "FIX.5.0";
 }
 
 namespace fixate {
@@ -151,30 +160,12 @@ namespace fixate {
         BeginString(const std::string& str = "") : Base(str) {}
         BeginString(const char* str, size_t strLen) : Base(str, strLen) {}
     };
-    struct FixVersion_4_0 : public BeginString<7> {
-        typedef BeginString<7> Base;
-        FixVersion_4_0() : Base() { Base::set("FIX.4.0"); }
-    };
-    struct FixVersion_4_1 : public BeginString<7> {
-        typedef BeginString<7> Base;
-        FixVersion_4_1() : Base() { Base::set("FIX.4.1"); }
-    };
-    struct FixVersion_4_2 : public BeginString<7> {
-        typedef BeginString<7> Base;
-        FixVersion_4_2() : Base() { Base::set("FIX.4.2"); }
-    };
-    struct FixVersion_4_3 : public BeginString<7> {
-        typedef BeginString<7> Base;
-        FixVersion_4_3() : Base() { Base::set("FIX.4.3"); }
-    };
-    struct FixVersion_4_4 : public BeginString<7> {
-        typedef BeginString<7> Base;
-        FixVersion_4_4() : Base() { Base::set("FIX.4.4"); }
-    };
-    struct FixVersion_5_0 : public BeginString<7> {
-        typedef BeginString<7> Base;
-        FixVersion_5_0() : Base() { Base::set("FIX.5.0"); }
-    };
+    struct FixVersion_4_0 : public TvpConstant<&TagBeginString, &BeginString_4_0> {};
+    struct FixVersion_4_1 : public TvpConstant<&TagBeginString, &BeginString_4_1> {};
+    struct FixVersion_4_2 : public TvpConstant<&TagBeginString, &BeginString_4_2> {};
+    struct FixVersion_4_3 : public TvpConstant<&TagBeginString, &BeginString_4_3> {};
+    struct FixVersion_4_4 : public TvpConstant<&TagBeginString, &BeginString_4_4> {};
+    struct FixVersion_5_0 : public TvpConstant<&TagBeginString, &BeginString_5_0> {};
     struct Account : public TvpStringFixed<32, &TagAccount> {};
     struct AdvId : public TvpStringFixed<32, &TagAdvId> {};
     struct AdvRefID : public TvpStringFixed<32, &TagAdvRefID> {};
@@ -239,26 +230,15 @@ namespace fixate {
     struct SenderCompId : public TvpStringFixed<32, &TagSenderCompId> {};
     struct SenderSubID : public TvpStringFixed<32, &TagSenderSubID> {};
     struct SendingDate : public TvpStringFixed<32, &TagSendingDate> {};
-    struct SendingTime : public TvpStringFixed<32, &TagSendingTime> {
-        typedef TvpStringFixed<32, &TagSendingTime> Base;
-        template <typename T = void>
-        void set(int64_t ts, bool utc = true, char prec = 'm') {
-            if (utc) { Base::usedLen = strfutc(&Base::value[0], ts, prec); }
-            else { Base::usedLen = strflocal(&Base::value[0], ts, prec); }
-        }
-        template <typename T = void>
-        void set(bool utc = true, char prec = 'm') {
-            return set(epoch_timestamp(), utc, prec);
-        }
-    };
+    struct SendingTime : public TvpUtcTimestamp<clock_precision::milliseconds, &TagSendingTime> {};
     struct Quantity : public TvpFloat<double, 32, &TagQuantity> {};
     struct Side : public TvpChar<&TagSide> {};
     struct Symbol : public TvpStringFixed<32, &TagSymbol> {};
     struct TargetCompId : public TvpStringFixed<32, &TagTargetCompId> {};
-    struct Text : public TvpStringFixed<256, &TagText> {};
+    struct Text : public TvpStringDynamic<&TagText> {};
     struct TimeInForce : public TvpChar<&TagTimeInForce> {};
     struct ValidUntilTime : public TvpStringFixed<32, &TagValidUntilTime> {};
-    struct TransactTime : public TvpStringFixed<32, &TagTransactTime> {};
+    struct TransactTime : public TvpUtcTimestamp<clock_precision::milliseconds, &TagTransactTime> {};
     struct RawDataLength : public TvpInteger<int, 16, &TagRawDataLength> {};
     struct RawData : public TvpStringDynamic<&TagRawData> {};
     struct PossResend : public TvpChar<&TagPossResend> {};
@@ -267,6 +247,7 @@ namespace fixate {
     struct OrdRejReason : public TvpInteger<int, 16, &TagOrdRejReason> {};
     struct HeartBtInt: public TvpInteger<int64_t, 32, &TagHeartBtInt> {};
     struct TestReqId : public TvpStringFixed<32, &TagTestReqId> {};
+    struct OrigSendingTime : public TvpUtcTimestamp<clock_precision::milliseconds, &TagOrigSendingTime> {};
     struct QuoteReqID : public TvpStringFixed<32, &TagQuoteReqID> {};
     struct BidPx : public TvpFloat<double, 32, &TagBidPx> {};
     struct OfferPx : public TvpFloat<double, 32, &TagOfferPx> {};
@@ -0,0 +1,215 @@
+/**
+* @file fixate/fixtimer.hpp
+* @author Mrityunjay Tripathi
+*
+* Hierarchical timer wheel run by the session thread, for heartbeats,
+* request timeouts and reconnect backoff.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+#ifndef FIXATE_FIXTIMER_HPP_
+#define FIXATE_FIXTIMER_HPP_
+
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "fixate/fixdatetime.hpp"
+
+namespace fixate {
+
+    //! Called with the time the wheel was advanced to.
+    using timer_callback = std::function<void(int64_t)>;
+
+    /**
+     * Timers on four levels of 64 slots, `tick` nanoseconds apart on the
+     * first level and 64 times coarser on each next one, so the wheel spans
+     * 2^24 ticks (4.6 hours at the default 1ms) and longer timers wait on
+     * the last level. Scheduling and cancelling are O(1), a timer moves
+     * down a level at most three times before it fires. Occupancy bitmaps
+     * let `advance` and `next_deadline` skip empty slots instead of walking
+     * every tick. Not thread safe, it is meant to be driven by the thread
+     * which polls the connection, see `FixEngine::timers`.
+     */
+    class timer_wheel
+    {
+    public:
+        using id_type = uint64_t;
+        static constexpr const id_type npos = 0;
+        static constexpr const int64_t DEFAULT_TICK_NS = 1000000;
+    public:
+        explicit timer_wheel(int64_t tick = DEFAULT_TICK_NS, size_t capacity = 0);
+
+        //! Run `callback` once the wheel is advanced to `deadline` (ns since epoch) or later.
+        id_type schedule_at(int64_t deadline, timer_callback callback);
+        id_type schedule_after(int64_t delay, timer_callback callback) {
+            return schedule_at(system_timestamp() + delay, std::move(callback));
+        }
+        //! False if the timer already fired or was cancelled.
+        bool cancel(id_type id);
+        //! Run every timer due by `now`, returns how many ran.
+        int advance(int64_t now);
+        //! When `advance` next has work, 0 if no timer is pending. May be before the earliest deadline.
+        int64_t next_deadline() const;
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+    private:
+        static constexpr const int LEVELS = 4;
+        static constexpr const int SLOT_BITS = 6;
+        static constexpr const int SLOTS = 1 << SLOT_BITS;
+        static constexpr const uint32_t NIL = UINT32_MAX;
+        struct node {
+            int64_t expire = 0;
+            uint32_t prev = NIL;
+            uint32_t next = NIL;
+            uint32_t generation = 1;
+            uint16_t slot = 0;
+            bool active = false;
+            timer_callback callback;
+        };
+        void insert(uint32_t i);
+        void unlink(uint32_t i);
+        void cascade(int level);
+        int64_t next_tick() const;
+    private:
+        int64_t tick;
+        int64_t current;
+        size_t count = 0;
+        std::vector<node> nodes;
+        uint32_t freeList = NIL;
+        uint32_t heads[LEVELS * SLOTS];
+        uint64_t occupied[LEVELS] = {};
+    };
+
+    inline timer_wheel::timer_wheel(int64_t tick, size_t capacity)
+        : tick(tick), current(system_timestamp() / tick)
+    {
+        nodes.reserve(capacity);
+        for (uint32_t& head : heads) head = NIL;
+    }
+
+    inline timer_wheel::id_type timer_wheel::schedule_at(int64_t deadline, timer_callback callback)
+    {
+        uint32_t i = freeList;
+        if (i != NIL) freeList = nodes[i].next;
+        else { i = nodes.size(); nodes.emplace_back(); }
+        node& n = nodes[i];
+        // Rounded up so that a timer never fires early, and at the earliest on the next tick.
+        n.expire = std::max((deadline + tick - 1) / tick, current + 1);
+        n.callback = std::move(callback);
+        n.active = true;
+        insert(i);
+        count++;
+        return id_type(n.generation) << 32 | i;
+    }
+
+    inline bool timer_wheel::cancel(id_type id)
+    {
+        uint32_t i = uint32_t(id);
+        if (i >= nodes.size() || nodes[i].generation != uint32_t(id >> 32) || !nodes[i].active) return false;
+        unlink(i);
+        node& n = nodes[i];
+        n.active = false;
+        n.generation++;
+        n.callback = nullptr;
+        n.next = freeList;
+        freeList = i;
+        count--;
+        return true;
+    }
+
+    inline void timer_wheel::insert(uint32_t i)
+    {
+        node& n = nodes[i];
+        // The level is that of the highest slot index where the expiry differs from now.
+        uint64_t diff = uint64_t(n.expire ^ current);
+        int level = 0;
+        while (level < LEVELS - 1 && (diff >> (SLOT_BITS * (level + 1))) != 0) level++;
+        int shift = SLOT_BITS * level;
+        int slot = int((n.expire >> shift) & (SLOTS - 1));
+        // Beyond the wheel, the last slot to come round.
+        if (level == LEVELS - 1 && (n.expire >> shift) - (current >> shift) >= SLOTS)
+            slot = int(((current >> shift) - 1) & (SLOTS - 1));
+        n.slot = uint16_t(level * SLOTS + slot);
+        n.prev = NIL;
+        n.next = heads[n.slot];
+        if (n.next != NIL) nodes[n.next].prev = i;
+        heads[n.slot] = i;
+        occupied[level] |= uint64_t(1) << slot;
+    }
+
+    inline void timer_wheel::unlink(uint32_t i)
+    {
+        node& n = nodes[i];
+        if (n.prev != NIL) nodes[n.prev].next = n.next;
+        else heads[n.slot] = n.next;
+        if (n.next != NIL) nodes[n.next].prev = n.prev;
+        if (heads[n.slot] == NIL) occupied[n.slot / SLOTS] &= ~(uint64_t(1) << (n.slot % SLOTS));
+    }
+
+    inline void timer_wheel::cascade(int level)
+    {
+        uint16_t slot = uint16_t(level * SLOTS + ((current >> (SLOT_BITS * level)) & (SLOTS - 1)));
+        uint32_t i = heads[slot];
+        heads[slot] = NIL;
+        occupied[level] &= ~(uint64_t(1) << (slot % SLOTS));
+        while (i != NIL) {
+            uint32_t next = nodes[i].next;
+            insert(i);
+            i = next;
+        }
+    }
+
+    inline int64_t timer_wheel::next_tick() const
+    {
+        int64_t best = INT64_MAX;
+        for (int level = 0; level < LEVELS; ++level) {
+            if (occupied[level] == 0) continue;
+            int shift = SLOT_BITS * level;
+            int index = int((current >> shift) & (SLOTS - 1));
+            // Bit j is the slot j + 1 after the current one.
+            uint64_t ahead = std::rotr(occupied[level], index + 1);
+            best = std::min(best, ((current >> shift) + std::countr_zero(ahead) + 1) << shift);
+        }
+        return best;
+    }
+
+    inline int64_t timer_wheel::next_deadline() const
+    {
+        if (count == 0) return 0;
+        return next_tick() * tick;
+    }
+
+    inline int timer_wheel::advance(int64_t now)
+    {
+        int64_t target = now / tick;
+        int fired = 0;
+        while (current < target) {
+            int64_t next = count == 0 ? INT64_MAX : next_tick();
+            if (next > target) { current = target; break; }
+            current = next;
+            for (int level = LEVELS - 1; level > 0; --level) {
+                if ((current & ((int64_t(1) << (SLOT_BITS * level)) - 1)) == 0) cascade(level);
+            }
+            uint16_t slot = uint16_t(current & (SLOTS - 1));
+            // One at a time, a callback may schedule or cancel timers.
+            while (heads[slot] != NIL) {
+                uint32_t i = heads[slot];
+                timer_callback callback = std::move(nodes[i].callback);
+                cancel(id_type(nodes[i].generation) << 32 | i);
+                callback(now);
+                fired++;
+            }
+        }
+        return fired;
+    }
+
+}
+
+#endif
@@ -0,0 +1,180 @@
+/**
+* @file fixate/ringbuffer.hpp
+* @author Mrityunjay Tripathi
+*
+* Virtual ring buffer, the data pages are mapped twice back to back so that
+* a read or write which wraps around the end of the ring stays contiguous.
+*
+* fixate is free software; you may redistribute it and/or modify it under the
+* terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+* BSD 2-Clause "Simplified" License along with fixate. If not, see
+* http://www.opensource.org/licenses/BSD-2-Clause for more information.
+*
+* Copyright (c) 2025, Mrityunjay Tripathi
+*/
+
+#ifndef FIXATE_RINGBUFFER_HPP_
+#define FIXATE_RINGBUFFER_HPP_
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <system_error>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "fixate/fixmemory.hpp"
+
+namespace fixate {
+
+    namespace details {
+
+        /**
+         * Map `header_size + capacity` bytes of `fd`, followed by a second
+         * mapping of the `capacity` data bytes, so that reads and writes which
+         * cross the end of the ring stay contiguous. The mappings start on an
+         * `alignment` boundary, which hugetlbfs backed files require.
+         */
+        inline char* map_mirrored(int fd, size_t header_size, size_t capacity, int prot, size_t alignment = 0)
+        {
+            size_t total = header_size + 2 * capacity;
+            char* base = alignment ? reserve_aligned(total, alignment) : static_cast<char*>(
+                    mmap(nullptr, total, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+            if (base == nullptr || base == MAP_FAILED) return nullptr;
+            if (mmap(base, header_size + capacity, prot, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+                    || mmap(base + header_size + capacity, capacity, prot, MAP_SHARED | MAP_FIXED, fd, header_size) == MAP_FAILED) {
+                munmap(base, total);
+                return nullptr;
+            }
+            return base;
+        }
+
+        inline size_t ring_capacity(size_t capacity, page_size pages = page_size::normal) {
+            size_t size = page_bytes(pages);
+            while (size < capacity) size <<= 1;
+            return size;
+        }
+    }
+
+    //! Capacity of a ring_buffer chosen at runtime.
+    static constexpr const size_t dynamic_capacity = 0;
+
+    /**
+     * Single threaded byte ring with a compile time `Capacity`, or a runtime
+     * one when `Capacity` is `dynamic_capacity`. Capacities are powers of 2
+     * and page multiples, rounded up to the huge page size when the
+     * `memory_policy` asks for hugetlbfs pages. The producer writes at
+     * `prefetch_tail` and commits with `move_tail`, the consumer reads at
+     * `prefetch_head` and releases with `move_head`; neither checks bounds.
+     */
+    template <size_t Capacity = dynamic_capacity>
+    class ring_buffer
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0 && Capacity % 4096 == 0,
+                "ring_buffer capacity must be a power of 2 multiple of the page size.");
+    public:
+        ring_buffer() { if constexpr (Capacity != dynamic_capacity) allocate(Capacity, "fixate-ring", memory_policy()); }
+        explicit ring_buffer(const memory_policy& policy, const char* name = "fixate-ring") {
+            static_assert(Capacity != dynamic_capacity, "capacity must be given at runtime.");
+            allocate(Capacity, name, policy);
+        }
+        explicit ring_buffer(size_t capacity, const char* name = "fixate-ring", const memory_policy& policy = memory_policy()) {
+            static_assert(Capacity == dynamic_capacity, "capacity is fixed at compile time.");
+            allocate(capacity, name, policy);
+        }
+        ring_buffer(const ring_buffer& other) = delete;
+        ring_buffer& operator=(const ring_buffer& other) = delete;
+        ring_buffer(ring_buffer&& other) { *this = std::move(other); }
+        ring_buffer& operator=(ring_buffer&& other) {
+            if (this != &other) {
+                release();
+                data = other.data; other.data = nullptr;
+                cap = other.cap; other.cap = 0;
+                backing = other.backing;
+                head = other.head; other.head = 0;
+                tail = other.tail; other.tail = 0;
+            }
+            return *this;
+        }
+        ~ring_buffer() { release(); }
+
+        bool valid() const { return data != nullptr; }
+        int capacity() const { return int(mask() + 1); }
+        int size() const { return int(tail - head); }
+        int free_space() const { return capacity() - size(); }
+        char* prefetch_head() const { return data + (head & mask()); }
+        char* prefetch_tail() const { return data + (tail & mask()); }
+        int move_head(int n) { head += n; return n; }
+        int move_tail(int n) { tail += n; return n; }
+        page_size pages() const { return backing; }
+        //! Fault the whole ring in, contents are left untouched.
+        void prefault() { if (data) details::prefault(data, mask() + 1); }
+
+        int enqueue(const char* buffer, int n) {
+            if (n > free_space()) return 0;
+            std::memcpy(prefetch_tail(), buffer, n);
+            return move_tail(n);
+        }
+        int dequeue(char* buffer, int n) {
+            if (n > size()) n = size();
+            std::memcpy(buffer, prefetch_head(), n);
+            return move_head(n);
+        }
+    private:
+        size_t mask() const {
+            if constexpr (Capacity != dynamic_capacity) return Capacity - 1;
+            else return cap - 1;
+        }
+        void allocate(size_t capacity, const char* name, const memory_policy& policy) {
+            backing = policy.pages;
+            while (true) {
+                bool hugetlb = details::is_hugetlb(backing);
+                size_t size = details::ring_capacity(capacity, hugetlb ? backing : page_size::normal);
+                if constexpr (Capacity != dynamic_capacity) {
+                    // A fixed capacity smaller than a huge page can't use hugetlbfs.
+                    if (size != Capacity) { hugetlb = false; size = Capacity; }
+                }
+                int ec = hugetlb ? map(size, name, MFD_HUGETLB | (details::page_shift(backing) << MAP_HUGE_SHIFT),
+                        details::page_bytes(backing)) : map(size, name, 0, backing == page_size::normal ? 0 : size_t(1) << 21);
+                if (ec == 0) {
+                    if (!hugetlb && backing != page_size::normal) backing = page_size::transparent;
+                    break;
+                }
+                if (!hugetlb || !policy.fallback) throw std::system_error(ec, std::generic_category(), "ring_buffer");
+                backing = details::smaller_pages(backing);
+            }
+            int ec = details::apply_policy(data, cap, backing, policy);
+            if (ec != 0) {
+                release();
+                throw std::system_error(ec, std::generic_category(), "mbind");
+            }
+        }
+        int map(size_t capacity, const char* name, unsigned flags, size_t alignment) {
+            int fd = memfd_create(name, MFD_CLOEXEC | flags);
+            if (fd < 0) return errno;
+            if (ftruncate(fd, capacity) != 0) {
+                int ec = errno; close(fd);
+                return ec;
+            }
+            data = details::map_mirrored(fd, 0, capacity, PROT_READ | PROT_WRITE, alignment);
+            int ec = errno;
+            close(fd);
+            if (data == nullptr) return ec;
+            cap = capacity;
+            return 0;
+        }
+        void release() {
+            if (data) munmap(data, 2 * cap);
+            data = nullptr;
+        }
+    private:
+        char* data = nullptr;
+        size_t cap = Capacity;
+        page_size backing = page_size::normal;
+        //! Producer and consumer cursors on their own cache lines.
+        alignas(64) uint64_t head = 0;
+        alignas(64) uint64_t tail = 0;
+    };
+
+}
+
+#endif
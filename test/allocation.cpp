@@ -0,0 +1,192 @@
+#include <new>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <iostream>
+#include "common.hpp"
+#include "fixate/fixbulk.hpp"
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t a = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+typedef FixMessage<
+    FixVersionType::FIX_4_4,
+    MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime, Text
+> Reject;
+
+using PxColumns = TvpColumnar<TvpGroup<BidPx, BidSize, OfferPx, OfferSize>>;
+
+typedef FixMessage<
+    FixVersionType::FIX_4_4,
+    MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime,
+    MDReqID, NoMDEntries, PxColumns
+> ColumnarMarketDataIncrementalRefresh;
+
+struct RoundTripVisitor
+{
+    object_pool<MarketDataIncrementalRefresh>* pool;
+    object_pool<Reject>* rejects;
+    object_pool<ColumnarMarketDataIncrementalRefresh>* columnar;
+    int mismatches = 0;
+    char d[8192];
+    char scratch[8192];
+    iovec iov[64];
+    template <typename TPool>
+    void roundTrip(TPool* p, const char* buffer, size_t n) {
+        auto msg = p->checkout();
+        msg->parse(buffer);
+        if (msg->dump(d, true, true) != int(n) || std::memcmp(d, buffer, n) != 0) mismatches++;
+        if (msg->encode(scratch) != std::string_view(buffer, n)) mismatches++;
+        checkGather(*msg, buffer, n);
+    }
+    //! The gathered message, with values of 64 bytes and more referenced, must be the same bytes.
+    template <typename TMessage>
+    void checkGather(TMessage& msg, const char* buffer, size_t n) {
+        iov_writer w(iov, 64, scratch, sizeof(scratch), 64);
+        if (msg.dump_iov(w) != int(n)) { mismatches++; return; }
+        size_t off = 0;
+        for (int i = 0; i < w.size(); ++i) {
+            if (std::memcmp(d + off, iov[i].iov_base, iov[i].iov_len) != 0) mismatches++;
+            off += iov[i].iov_len;
+        }
+        if (off != n) mismatches++;
+    }
+    void operator()(MessageTypeEnum msgType, const char* buffer, size_t n)
+    {
+        if (msgType == MessageTypeEnum::Reject) roundTrip(rejects, buffer, n);
+        else {
+            roundTrip(pool, buffer, n);
+            roundTrip(columnar, buffer, n);
+            checkColumns(buffer);
+        }
+    }
+    //! Decoded columns must hold what the text based group reads back.
+    void checkColumns(const char* buffer) {
+        auto rows = pool->checkout();
+        auto columns = columnar->checkout();
+        rows->parse(buffer);
+        columns->parse(buffer);
+        const PxColumns& group = columns->field<PxColumns>();
+        for (int i = 0; i < rows->get<NoMDEntries>(); ++i) {
+            if (group.column<BidPx>()[i] != rows->get<PxArray, BidPx>(i)
+                    || group.column<OfferSize>()[i] != rows->get<PxArray, OfferSize>(i)) mismatches++;
+        }
+    }
+};
+
+/**
+ * Writers running out of entries copy what they would reference, for
+ * every capacity the gathered bytes must be those written.
+ */
+static int iov_exhaustion_mismatches()
+{
+    int mismatches = 0;
+    char scratch[1024];
+    iovec iov[8];
+    const std::string a(100, 'a'), b(100, 'b');
+    const std::string expected = "x" + a + "y" + b + "z";
+    for (int capacity = 1; capacity <= 8; ++capacity) {
+        iov_writer w(iov, capacity, scratch, sizeof(scratch), 64);
+        w.copy("x", 1);
+        w.reference(a.data(), a.size());
+        w.copy("y", 1);
+        w.reference(b.data(), b.size());
+        w.copy("z", 1);
+        w.flush();
+        std::string gathered;
+        for (int i = 0; i < w.size(); ++i) gathered.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+        mismatches += gathered != expected || w.bytes() != expected.size() || w.size() > capacity;
+    }
+    return mismatches;
+}
+
+/**
+ * Parse MarketDataIncrementalRefresh messages of varying group sizes and
+ * Reject messages with free text around the inline capacity into pooled
+ * messages, once to reach the high-water mark and once more counting heap
+ * allocations, which must be zero. Every parsed message must dump back to
+ * the bytes it was parsed from, with text and columnar groups alike,
+ * through `encode` and gathered into an iovec list, as must a long Text
+ * parsed on a thread which has since exited, and what writers short of
+ * entries gather.
+ */
+int allocation_test(int N)
+{
+    char buffer[8192];
+    std::string log;
+    Reject r;
+    r.set<MessageType>(MessageTypeEnum::Reject);
+    r.set<TargetCompId>("TSERVER");
+    r.set<SenderCompId>("DERIBITSERVER");
+    MarketDataIncrementalRefresh g;
+    g.set<MessageType>(MessageTypeEnum::MarketDataIncrementalRefresh);
+    g.set<TargetCompId>("TSERVER");
+    g.set<SenderCompId>("DERIBITSERVER");
+    for (int i = 0; i < N; ++i) {
+        if (i % 4 == 3) {
+            r.set<MsgSeqNum>(i);
+            r.set<SendingTime>();
+            r.set<Text>(std::string(random_number(1, 160), 'a' + i % 26));
+            log.append(buffer, r.dump(buffer, true, true));
+            continue;
+        }
+        int noMdEntries = random_number(1, 16);
+        g.set<MsgSeqNum>(i);
+        g.set<SendingTime>();
+        g.set<MDReqID>(std::to_string(i));
+        g.set<NoMDEntries>(noMdEntries);
+        g.resize<PxArray>(noMdEntries);
+        for (int j = 0; j < noMdEntries; ++j) {
+            g.set<PxArray, BidPx>(j, random_number(100.0, 200.0), 2);
+            g.set<PxArray, BidSize>(j, random_number(1.0, 20.0), 1);
+            g.set<PxArray, OfferPx>(j, random_number(200.0, 300.0), 2);
+            g.set<PxArray, OfferSize>(j, random_number(1.0, 20.0), 1);
+        }
+        log.append(buffer, g.dump(buffer, true, true));
+    }
+
+    object_pool<MarketDataIncrementalRefresh> pool(4);
+    object_pool<Reject> rejects(4);
+    object_pool<ColumnarMarketDataIncrementalRefresh> columnar(4);
+    RoundTripVisitor mv{&pool, &rejects, &columnar};
+    auto run = [&]() {
+        mapped_chunk source(log.data(), log.data() + log.size());
+        FixEngine<mapped_chunk, RoundTripVisitor> e(&source, &mv);
+        e.connect();
+        while (source.active()) e.perform();
+    };
+    run();
+    // Text spilled on a thread that has exited, then copied and moved, reads back the same.
+    r.set<Text>(std::string(200, 'x'));
+    int n = r.dump(buffer, true, true);
+    Reject parsed;
+    std::thread([&]() { parsed.parse(buffer); }).join();
+    Reject copied(parsed);
+    Reject moved(std::move(copied));
+    mv.mismatches += parsed.dump(mv.d, true, true) != n || std::memcmp(mv.d, buffer, n) != 0;
+    mv.mismatches += moved.dump(mv.d, true, true) != n || std::memcmp(mv.d, buffer, n) != 0;
+    mv.mismatches += iov_exhaustion_mismatches();
+    uint64_t before = allocations.load();
+    run();
+    uint64_t count = allocations.load() - before;
+    std::cout << "Steady state allocations: " << count << " over " << N << " messages, "
+              << mv.mismatches << " round trip mismatches" << std::endl;
+    return count == 0 && mv.mismatches == 0;
+}
@@ -0,0 +1,122 @@
+#include <map>
+#include <random>
+#include <iostream>
+#include "common.hpp"
+
+namespace {
+
+    template <clock_precision Prec>
+    bool same(int64_t ts) {
+        char expected[32], cached[32];
+        size_t n = strfutc<Prec>(expected, ts);
+        size_t m = strfutc_cached<Prec>(cached, ts);
+        if (n == m && std::memcmp(expected, cached, n) == 0) return true;
+        std::cout << "strfutc: " << std::string(expected, n) << ", cached: " << std::string(cached, m) << std::endl;
+        return false;
+    }
+
+    //! strtutc of the formatted stamp gives it back, truncated to the precision.
+    template <clock_precision Prec>
+    bool parses(int64_t ts) {
+        static constexpr const int64_t UNIT[] = {1000000000LL, 1000000LL, 1000LL, 1LL};
+        char buffer[32];
+        size_t n = strfutc<Prec>(buffer, ts);
+        int64_t parsed = strtutc(buffer, n);
+        if (parsed == ts - ts % UNIT[int(Prec)]) return true;
+        std::cout << "strtutc: " << std::string(buffer, n) << " -> " << parsed << ", expected " << ts << std::endl;
+        return false;
+    }
+
+    /**
+     * Random schedules, cancels and jumps of the clock against a map of
+     * deadlines. Every timer must fire, after its deadline and by the
+     * first advance at least a tick past it.
+     */
+    int timer_mismatches(int N) {
+        std::mt19937_64 rng(N);
+        timer_wheel wheel;
+        int64_t now = system_timestamp();
+        std::map<int, std::pair<timer_wheel::id_type, int64_t>> pending;
+        int mismatches = 0;
+        for (int i = 0; i < N; ++i) {
+            int op = rng() % 10;
+            if (op < 5) {
+                // Mostly within seconds, some past the 4.6 hours the wheel spans.
+                int64_t deadline = now + int64_t(rng() % (op == 0 ? 20000000000000ULL : 5000000000ULL));
+                auto id = wheel.schedule_at(deadline, [&, i](int64_t at) {
+                    mismatches += at < pending[i].second;
+                    pending.erase(i);
+                });
+                pending[i] = {id, deadline};
+            }
+            else if (op < 7 && !pending.empty()) {
+                auto it = std::next(pending.begin(), rng() % pending.size());
+                mismatches += !wheel.cancel(it->second.first);
+                pending.erase(it);
+            }
+            else {
+                now += int64_t(rng() % (op == 9 ? 1000000000000ULL : 100000000ULL));
+                wheel.advance(now);
+                for (const auto& p : pending) mismatches += p.second.second + timer_wheel::DEFAULT_TICK_NS <= now;
+            }
+            mismatches += wheel.size() != pending.size();
+        }
+        return mismatches;
+    }
+}
+
+/**
+ * The cached UTC formatter against strfutc, and strtutc reading strfutc
+ * back, at every precision, on stamps walking forward through a second
+ * and jumping between days, years and leap days, and the timer wheel.
+ */
+int datetime_test(int N)
+{
+    std::mt19937_64 rng(N);
+    int mismatches = 0;
+    int64_t ts = system_timestamp();
+    for (int i = 0; i < N; ++i) {
+        if (i % 64 == 0) ts = int64_t(rng() % 4102444800ULL) * 1000000000LL + int64_t(rng() % 1000000000ULL);
+        else ts += int64_t(rng() % 50000000ULL);
+        mismatches += !same<clock_precision::seconds>(ts);
+        mismatches += !same<clock_precision::milliseconds>(ts);
+        mismatches += !same<clock_precision::microseconds>(ts);
+        mismatches += !same<clock_precision::nanoseconds>(ts);
+        mismatches += !parses<clock_precision::seconds>(ts);
+        mismatches += !parses<clock_precision::milliseconds>(ts);
+        mismatches += !parses<clock_precision::microseconds>(ts);
+        mismatches += !parses<clock_precision::nanoseconds>(ts);
+    }
+    for (const char* bad : {"20250230-00:00:00", "20250101-24:00:00", "20250101 00:00:00", "2025010a-00:00:00",
+            "20250101-00:00:00.", "20250101-00:00:00.1x3", "20250101-00-00:00"})
+        mismatches += strtutc(std::string_view(bad)) != INVALID_TIMESTAMP;
+    // 2024-02-29 23:59:59.999999999 and the stamp after it.
+    mismatches += !same<clock_precision::nanoseconds>(1709251199999999999LL);
+    mismatches += !same<clock_precision::nanoseconds>(1709251200000000000LL);
+    // SendingTime keeps nanoseconds, renders milliseconds and keeps parsed text as it came.
+    SendingTime sent(1709251199123456789LL), received;
+    char field[64];
+    TvpParseData pd(field);
+    int n = sent.dump(field);
+    mismatches += received.parse(pd) != n || received.get() != 1709251199123000000LL || received.text() != sent.text();
+    std::memcpy(field, "52=20240229-23:59:59.123456\x01", 28);
+    pd = TvpParseData(field);
+    mismatches += received.parse(pd) != 28 || received.get() != 1709251199123456000LL || received.dump(field + 32) != 28;
+    std::cout << "UTC timestamps: " << N << ", " << mismatches << " mismatches" << std::endl;
+    int timers = timer_mismatches(N);
+    std::cout << "Timers: " << N << " operations, " << timers << " mismatches" << std::endl;
+    mismatches += timers;
+    if (!tsc_clock::supported()) return mismatches == 0;
+    // The TSC clock against CLOCK_REALTIME, readings bracketed by the two.
+    tsc_clock& clock = tsc_clock::instance();
+    clock.resync();
+    int64_t worst = 0;
+    for (int i = 0; i < N; ++i) {
+        int64_t before = realtime_timestamp();
+        int64_t t = clock.now();
+        int64_t after = realtime_timestamp();
+        worst = std::max(worst, std::max(before - t, t - after));
+    }
+    std::cout << "TSC clock: " << clock.frequency() / 1e6 << " MHz, worst error " << worst << " ns" << std::endl;
+    return mismatches == 0 && worst < 1000000;
+}
@@ -0,0 +1,120 @@
+#include <string>
+#include <iostream>
+#include "common.hpp"
+// Generated by the Makefile from test/data/FIX44.xml and examples/deribit.xml.
+#include "deribit_fix.hpp"
+
+namespace {
+
+    namespace d = fixate::deribit;
+    using Entries = d::MarketDataIncrementalRefreshMDEntriesGroup;
+
+    std::string wire(std::string text) {
+        for (auto& c : text) if (c == '|') c = SEPARATOR;
+        return text;
+    }
+
+    //! Dump `msg`, parse it back and dump that, both renderings must match.
+    template <typename TMessage>
+    int round_trip(TMessage& msg, TMessage& parsed) {
+        char first[4096], second[4096];
+        int n = msg.dump(first, true, true);
+        int consumed = parsed.parse(first);
+        int m = parsed.dump(second, true, true);
+        return (consumed != n) + (std::string(first, n) != std::string(second, m));
+    }
+
+    //! Symbol, added by the overlay, both at the top and in the entries.
+    int incremental()
+    {
+        d::MarketDataIncrementalRefresh m;
+        m.set<d::SenderCompID>("DERIBITSERVER");
+        m.set<d::TargetCompID>("FIXCLIENT");
+        m.set<MsgSeqNum>(7);
+        m.set<SendingTime>();
+        m.set<Symbol>("BTC-PERPETUAL");
+        m.set<d::MarkPrice>(100.25, 2);
+        m.set<NoMDEntries>(2);
+        m.resize<Entries>(2);
+        m.set<Entries, MDUpdateAction>(0, char(d::MDUpdateActionEnum::New));
+        m.set<Entries, MDEntryType>(0, char(d::MDEntryTypeEnum::Bid));
+        m.set<Entries, Symbol>(0, "BTC-PERPETUAL");
+        m.set<Entries, MDEntryPx>(0, 100.5, 1);
+        m.set<Entries, MDEntrySize>(0, 3.0, 1);
+        m.set<Entries, MDUpdateAction>(1, char(d::MDUpdateActionEnum::Delete));
+        m.set<Entries, MDEntryType>(1, char(d::MDEntryTypeEnum::Offer));
+        m.set<Entries, MDEntryPx>(1, 101.0, 1);
+        m.set<Entries, d::DeribitTradeId>(1, "T-1");
+        d::MarketDataIncrementalRefresh p;
+        int mismatches = round_trip(m, p);
+        mismatches += p.get<Symbol>() != "BTC-PERPETUAL" || p.get<d::MarkPrice>() != 100.25;
+        mismatches += p.get<NoMDEntries>() != 2 || p.get<Entries, MDEntryPx>(0) != 100.5;
+        mismatches += p.get<Entries, MDUpdateAction>(1) != '2' || p.get<Entries, d::DeribitTradeId>(1) != "T-1";
+        return mismatches;
+    }
+
+    //! Fields out of dictionary order, with tags the dialect doesn't have in the body and in an entry.
+    int unknown_tags()
+    {
+        std::string raw = wire("8=FIX.4.4|9=000|35=X|49=DERIBITSERVER|56=FIXCLIENT|34=9|52=20250101-00:00:00.000|"
+                               "999=z|55=ETH-PERPETUAL|268=2|279=0|269=0|270=5|271=1|"
+                               "279=1|269=1|270=6|5555=q|271=2|100090=3.5|10=000|");
+        d::MarketDataIncrementalRefresh p;
+        int mismatches = p.parse(raw.c_str()) != int(raw.size());
+        mismatches += p.get<Symbol>() != "ETH-PERPETUAL" || p.get<NoMDEntries>() != 2;
+        mismatches += p.get<Entries, MDEntryPx>(1) != 6.0 || p.get<Entries, MDEntrySize>(1) != 2.0;
+        mismatches += p.get<d::MarkPrice>() != 3.5;
+        return mismatches;
+    }
+
+    int requests()
+    {
+        d::Logon logon;
+        logon.set<d::SenderCompID>("FIXCLIENT");
+        logon.set<d::TargetCompID>("DERIBITSERVER");
+        logon.set<MsgSeqNum>(1);
+        logon.set<SendingTime>();
+        logon.set<HeartBtInt>(15);
+        logon.set<Username>("WObvEb02");
+        logon.set<d::CancelOnDisconnect>('Y');
+        logon.set<d::CancelOnDisconnectType>(char(d::CancelOnDisconnectTypeEnum::Session));
+        d::Logon parsedLogon;
+        int mismatches = round_trip(logon, parsedLogon);
+        mismatches += parsedLogon.get<d::CancelOnDisconnect>() != 'Y' || parsedLogon.get<HeartBtInt>() != 15;
+
+        d::MarketDataRequest request;
+        request.set<d::SenderCompID>("FIXCLIENT");
+        request.set<MsgSeqNum>(2);
+        request.set<SendingTime>();
+        request.set<MDReqID>("R1");
+        request.set<SubscriptionRequestType>(char(d::SubscriptionRequestTypeEnum::SnapshotPlusUpdates));
+        request.set<MarketDepth>(0);
+        request.set<NoMDEntryTypes>(2);
+        request.resize<d::MDEntryTypesGroup>(2);
+        request.set<d::MDEntryTypesGroup, MDEntryType>(0, '0');
+        request.set<d::MDEntryTypesGroup, MDEntryType>(1, '1');
+        request.set<NoRelatedSym>(1);
+        request.resize<d::RelatedSymGroup>(1);
+        request.set<d::RelatedSymGroup, Symbol>(0, "BTC-PERPETUAL");
+        d::MarketDataRequest parsedRequest;
+        mismatches += round_trip(request, parsedRequest);
+        mismatches += parsedRequest.get<d::MDEntryTypesGroup, MDEntryType>(1) != '1';
+        mismatches += parsedRequest.get<d::RelatedSymGroup, Symbol>(0) != "BTC-PERPETUAL";
+
+        mismatches += d::MsgTypeStringToEnum("X") != d::MsgTypeEnum::MarketDataIncrementalRefresh;
+        mismatches += d::MsgTypeStringToEnum("ZZ") != d::MsgTypeEnum(-1);
+        return mismatches;
+    }
+}
+
+/**
+ * Messages of the Deribit dialect generated by tools/fixgen.py, dumped and
+ * parsed back, and parsed from text with fields out of order and tags the
+ * dialect doesn't have.
+ */
+int fixgen_test()
+{
+    int mismatches = incremental() + unknown_tags() + requests();
+    std::cout << "Fixgen: 4 messages, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
@@ -5,6 +5,13 @@
 #include <fstream>
 #include "common.hpp"
 
+int allocation_test(int N);
+int datetime_test(int N);
+int pcap_test(const char* filename);
+int orders_test();
+int fixgen_test();
+int send_test();
+
 int writer(int N, const char* filename) {
     std::ofstream file;
     file.open(filename);
@@ -119,21 +126,27 @@ int reader(const char* filename)
 int main(int argc, const char* argv[])
 {
     if (argc < 2) {
-        std::cout << "Usage:\n\t<test read/write/both>\n";
+        std::cout << "Usage:\n\t<test read/write/both/alloc/time/pcap/orders/gen/send>\n";
         return -1;
     }
     char q = argv[1][0];
+    if (q == 'o') return orders_test() ? 0 : -1;
+    if (q == 'g') return fixgen_test() ? 0 : -1;
+    if (q == 's') return send_test() ? 0 : -1;
     if (argc < 3) {
-        std::cout << "Usage:\n\t<test read/write/both> <filename>\n";
+        std::cout << "Usage:\n\t<test read/write/both/alloc/time/pcap/orders/gen/send> <filename>\n";
         return -1;
     }
-    if ((q == 'w' || q == 'b') && (argc < 4)) {
-        std::cout << "Usage:\n\t<test read/write/both> <filename> <msg count>\n";
+    if ((q == 'w' || q == 'b' || q == 'a' || q == 't') && (argc < 4)) {
+        std::cout << "Usage:\n\t<test read/write/both/alloc/time/pcap/orders/gen/send> <filename> <msg count>\n";
         return -1;
     }
     const char* filename = argv[2];
+    if (q == 'p') return pcap_test(filename) ? 0 : -1;
     int N = std::stoi(argv[3]);
 
+    if (q == 'a') return allocation_test(N) ? 0 : -1;
+    if (q == 't') return datetime_test(N) ? 0 : -1;
     if (!writer(N, filename)) return -1;
     if (!reader(filename)) return -1;
     return 0;
@@ -0,0 +1,186 @@
+#include <set>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "common.hpp"
+#include "fixate/fixorders.hpp"
+
+namespace {
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, ClOrdID, Side, OrderType, OrderQty, Price
+    > NewOrder;
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, ClOrdID, OrigClOrdID, OrderQty, Price
+    > ReplaceRequest;
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, ClOrdID, OrigClOrdID, OrderID, ExecType, OrderStatus, CumQty, LeavesQty, AvgPx
+    > Report;
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, ClOrdID, OrigClOrdID, OrderID, OrderStatus
+    > CancelReject;
+
+    const size_t CAPACITY = 8;
+
+    struct Session
+    {
+        OrderStore store{CAPACITY};
+
+        OrderRecord* order(const char* clOrdID) {
+            NewOrder msg;
+            msg.set<ClOrdID>(clOrdID);
+            msg.set<Side>('1');
+            msg.set<OrderType>('2');
+            msg.set<OrderQty>(10.0, 1);
+            msg.set<Price>(100.0, 1);
+            return store.onNewOrder(msg);
+        }
+        OrderRecord* replace(const char* clOrdID, const char* origClOrdID) {
+            ReplaceRequest msg;
+            msg.set<ClOrdID>(clOrdID);
+            msg.set<OrigClOrdID>(origClOrdID);
+            msg.set<OrderQty>(20.0, 1);
+            msg.set<Price>(101.0, 1);
+            return store.onReplaceRequest(msg);
+        }
+        OrderRecord* report(const char* clOrdID, const char* origClOrdID, char execType, char ordStatus, double cumQty) {
+            Report msg;
+            msg.set<ClOrdID>(clOrdID);
+            msg.set<OrigClOrdID>(origClOrdID);
+            msg.set<OrderID>("X1");
+            msg.set<ExecType>(execType);
+            msg.set<OrderStatus>(ordStatus);
+            msg.set<CumQty>(cumQty, 1);
+            msg.set<LeavesQty>(10.0 - cumQty, 1);
+            msg.set<AvgPx>(100.0, 1);
+            return store.onExecutionReport(msg);
+        }
+        OrderRecord* reject(const char* clOrdID, const char* origClOrdID, char ordStatus) {
+            CancelReject msg;
+            msg.set<ClOrdID>(clOrdID);
+            msg.set<OrigClOrdID>(origClOrdID);
+            msg.set<OrderID>("X1");
+            msg.set<OrderStatus>(ordStatus);
+            return store.onCancelReject(msg);
+        }
+
+        //! The store hands out every slot exactly once, a double free would repeat one.
+        bool intact() {
+            size_t live = store.size();
+            std::set<OrderRecord*> added;
+            std::vector<std::string> ids;
+            for (size_t i = live; i < CAPACITY; ++i) {
+                ids.push_back(std::to_string(i));
+                added.insert(store.add(ids.back()));
+            }
+            bool ok = added.size() == CAPACITY - live && added.count(nullptr) == 0 && store.add("F") == nullptr;
+            for (const auto& id : ids) {
+                if (OrderRecord* r = store.find(id)) store.remove(r);
+            }
+            return ok && store.size() == live;
+        }
+    };
+
+    //! new, ack, replace, the original fills before the replace is answered, too late to replace.
+    int fill_before_replace()
+    {
+        Session s;
+        int mismatches = 0;
+        s.order("A");
+        s.report("A", "", '0', '0', 0.0);
+        OrderRecord* b = s.replace("B", "A");
+        mismatches += b == nullptr || b->replaces != s.store.indexOf(s.store.find("A"));
+        s.report("A", "", 'F', '2', 10.0);
+        mismatches += s.store.find("A") != nullptr;
+        mismatches += b->replaces != OrderStore::npos;
+        OrderRecord* r = s.reject("B", "A", '2');
+        mismatches += r != b || s.store.find("B") != nullptr || s.store.size() != 0;
+        mismatches += !s.intact();
+        return mismatches;
+    }
+
+    //! new, ack, replace, the original fills, then a stray Replaced for the replacement.
+    int fill_then_replaced()
+    {
+        Session s;
+        int mismatches = 0;
+        s.order("A");
+        s.report("A", "", '0', '0', 0.0);
+        s.replace("B", "A");
+        s.report("A", "", 'F', '2', 10.0);
+        OrderRecord* b = s.report("B", "A", '5', '0', 0.0);
+        mismatches += b == nullptr || s.store.size() != 1 || s.store.find("B") != b;
+        mismatches += !s.intact();
+        return mismatches;
+    }
+
+    //! new, ack, replace, accepted, then the replacement fills.
+    int replaced()
+    {
+        Session s;
+        int mismatches = 0;
+        s.order("A");
+        s.report("A", "", '0', '0', 0.0);
+        OrderRecord* b = s.replace("B", "A");
+        mismatches += s.replace("C", "A") != nullptr;
+        mismatches += s.report("B", "A", '5', '0', 0.0) != b;
+        mismatches += s.store.find("A") != nullptr || s.store.size() != 1;
+        mismatches += b->replaces != OrderStore::npos || s.store.findByOrderID("X1") != b;
+        mismatches += b->orderQty != 20.0 || b->price != 101.0;
+        mismatches += !s.intact();
+        mismatches += s.report("B", "", 'F', '2', 10.0) != b || s.store.size() != 0;
+        mismatches += !s.intact();
+        return mismatches;
+    }
+
+    //! new, ack, replace, rejected, then a second replace of the same order.
+    int replace_rejected()
+    {
+        Session s;
+        int mismatches = 0;
+        OrderRecord* a = s.order("A");
+        s.report("A", "", '0', '0', 0.0);
+        s.replace("B", "A");
+        mismatches += s.reject("B", "A", '0') != a;
+        mismatches += s.store.find("B") != nullptr || s.store.find("A") != a || s.store.size() != 1;
+        mismatches += a->replacedBy != OrderStore::npos || a->ordStatus != '0' || a->orderQty != 10.0;
+        OrderRecord* c = s.replace("C", "A");
+        mismatches += c == nullptr || a->replacedBy != s.store.indexOf(c);
+        mismatches += !s.intact();
+        return mismatches;
+    }
+
+    //! new, ack, replace, the replace is rejected because the original already filled.
+    int replace_rejected_filled()
+    {
+        Session s;
+        int mismatches = 0;
+        s.order("A");
+        s.report("A", "", '0', '0', 0.0);
+        s.replace("B", "A");
+        s.reject("B", "A", '2');
+        mismatches += s.store.size() != 0;
+        mismatches += !s.intact();
+        return mismatches;
+    }
+}
+
+/**
+ * OrderStore through new, replace and fill/reject/replaced sequences,
+ * checking the links between an order and its pending replacement and
+ * that no record is freed twice.
+ */
+int orders_test()
+{
+    int mismatches = fill_before_replace() + fill_then_replaced() + replaced()
+        + replace_rejected() + replace_rejected_filled();
+    std::cout << "OrderStore: 5 sequences, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
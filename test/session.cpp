@@ -0,0 +1,64 @@
+#include <string>
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <unistd.h>
+#include "common.hpp"
+
+namespace {
+
+    typedef FixMessage<
+        FixVersionType::FIX_4_4,
+        MessageType, MsgSeqNum, SenderCompId, TargetCompId, SendingTime, RawDataLength, RawData
+    > RawDataMessage;
+
+    struct IgnoreVisitor
+    {
+        void operator()(MessageTypeEnum msgType, const char* buffer, size_t n) {}
+    };
+
+    const int PORT = 19882;
+}
+
+/**
+ * Gather writes to a session whose acceptor has gone. The first may still
+ * land in the socket buffer, a later one fails with EPIPE or ECONNRESET and
+ * must disconnect the client and return what was written, rather than spin
+ * on the dead socket.
+ */
+int send_test()
+{
+    // A send that never returns would hang the test, end it instead.
+    alarm(10);
+    int errors = 0;
+    tcp_server server("127.0.0.1", PORT, [](){}, [](){}, [](int, const std::string&){});
+    server.set_accept_timeout(3000);
+    tcp_client client("127.0.0.1", PORT, [](){}, [](){}, [&](int, const std::string&){ errors++; });
+    std::thread acceptor([&]() { server.connect(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    client.connect();
+    acceptor.join();
+    server.disconnect();
+
+    IgnoreVisitor visitor;
+    FixEngine<tcp_client, IgnoreVisitor> engine(&client, &visitor);
+    RawDataMessage msg;
+    msg.set<MessageType>(MessageTypeEnum::Logon);
+    msg.set<SenderCompId>("CLIENT");
+    msg.set<TargetCompId>("SERVER");
+    msg.set<SendingTime>();
+    msg.set<RawDataLength>(16384);
+    msg.set<RawData>(std::string(16384, 'x'));
+    int sends = 0;
+    size_t last = 0;
+    for (; sends < 64 && client.active(); ++sends) {
+        msg.set<MsgSeqNum>(sends + 1);
+        last = engine.sendmsg_iov(msg);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    alarm(0);
+    int mismatches = client.active() + (last >= 16384) + (errors != 1);
+    std::cout << "Send to closed peer: " << sends << " sends, " << errors << " errors, "
+              << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
@@ -0,0 +1,576 @@
+#!/usr/bin/env python3
+#
+# fixate is free software; you may redistribute it and/or modify it under the
+# terms of the BSD 2-Clause "Simplified" License. You should have received a copy of the
+# BSD 2-Clause "Simplified" License along with fixate. If not, see
+# http://www.opensource.org/licenses/BSD-2-Clause for more information.
+#
+# Copyright (c) 2025, Mrityunjay Tripathi
+"""
+Generate fixate message types from a QuickFIX style data dictionary.
+
+    tools/fixgen.py FIX44.xml --overlay examples/deribit.xml --namespace deribit -o deribit_fix.hpp
+
+Overlays use the dictionary's own format and are applied in order. Fields
+and components replace those of the same name. A message of an existing
+name has its fields, and those of its groups, added ahead of its groups,
+or is replaced with replace="Y". Header and trailer fields are appended.
+A field may not follow a group having the same tag in its entries. A field
+may give the capacity of its value with length="N" and override its type,
+e.g. type="DATA" for a long string.
+
+The header holds, in the namespace of the dialect:
+  - Tag constants and field structs, for fields used by the messages,
+  - value enums of CHAR, BOOLEAN and INT fields,
+  - repeating groups as TvpVector of an entry struct,
+  - the standard header, and a Message template over FixMessage which
+    starts the body with MsgType as a TvpConstant,
+  - MsgTypeEnum with its MsgType strings and conversions,
+  - a struct per message, whose body parse switches on the tag number of
+    every field, so fields are taken in any order and unknown tags are
+    stepped over. An entry of a group ends at its delimiter or at another
+    tag of the dialect.
+
+Fields already defined by fixate (include/fixate/fixtags.hpp, and any
+header given with --reuse) are referred to rather than redefined, so
+generated messages work with everything written against fixate's types.
+"""
+
+import argparse
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+FIXTAGS = os.path.join(REPO, 'include', 'fixate', 'fixtags.hpp')
+
+# Tags the FixMessage frame writes itself.
+FRAME_TAGS = {8, 9, 10}
+MSGTYPE_TAG = 35
+
+FLOAT_TYPES = {'FLOAT', 'PRICE', 'QTY', 'AMT', 'PRICEOFFSET', 'PERCENTAGE'}
+CHAR_TYPES = {'CHAR', 'BOOLEAN'}
+INT_TYPES = {'INT', 'LENGTH', 'DAYOFMONTH', 'TAGNUM'}
+DYNAMIC_TYPES = {'DATA', 'XMLDATA'}
+
+
+def fail(msg):
+    sys.exit('fixgen: ' + msg)
+
+
+class Field:
+    def __init__(self, number, name, ftype, length=None, values=None):
+        self.number = number
+        self.name = name
+        self.type = ftype
+        self.length = length
+        self.values = values or []
+
+
+class Dictionary:
+    def __init__(self):
+        self.major = None
+        self.minor = None
+        self.fields = {}        # name -> Field
+        self.components = {}    # name -> [item]
+        self.header = []
+        self.trailer = []
+        self.messages = {}      # name -> (msgtype, [item])
+        self.order = []         # message names in dictionary order
+
+
+def read_items(node):
+    """Members of a message, component or group as ('field'|'component'|'group', name, items)."""
+    items = []
+    for child in node:
+        name = child.get('name')
+        if child.tag == 'field':
+            items.append(('field', name, None))
+        elif child.tag == 'component':
+            items.append(('component', name, None))
+        elif child.tag == 'group':
+            items.append(('group', name, read_items(child)))
+    return items
+
+
+def append_items(items, extra):
+    """
+    Add the members of `extra` which `items` lacks, a group of the same name
+    takes those of its namesake. Fields and components go ahead of the first
+    group, where a tag the entries also have can't be read as part of the
+    last entry.
+    """
+    existing = {(kind, name): sub for kind, name, sub in items}
+    for kind, name, sub in extra:
+        if (kind, name) not in existing:
+            first_group = next((i for i, item in enumerate(items) if item[0] == 'group'), len(items))
+            items.insert(len(items) if kind == 'group' else first_group, (kind, name, sub))
+        elif kind == 'group':
+            append_items(existing[(kind, name)], sub)
+
+
+def load(path, dictionary, overlay):
+    try:
+        root = ET.parse(path).getroot()
+    except (OSError, ET.ParseError) as e:
+        fail('%s: %s' % (path, e))
+    if root.tag != 'fix':
+        fail('%s: not a FIX data dictionary' % path)
+    if root.get('major') is not None:
+        dictionary.major = root.get('major')
+        dictionary.minor = root.get('minor')
+    for node in root.findall('fields/field'):
+        old = dictionary.fields.get(node.get('name'))
+        number = node.get('number') or (old and str(old.number))
+        ftype = node.get('type') or (old and old.type)
+        if number is None or ftype is None:
+            fail('%s: field %s needs a number and a type' % (path, node.get('name')))
+        values = [(v.get('enum'), v.get('description')) for v in node.findall('value')]
+        if not values and old is not None:
+            values = old.values
+        length = node.get('length')
+        dictionary.fields[node.get('name')] = Field(
+            int(number), node.get('name'), ftype.upper(), int(length) if length else None, values)
+    for node in root.findall('components/component'):
+        dictionary.components[node.get('name')] = read_items(node)
+    for part in ('header', 'trailer'):
+        node = root.find(part)
+        if node is not None:
+            append_items(getattr(dictionary, part), read_items(node))
+    for node in root.findall('messages/message'):
+        name = node.get('name')
+        items = read_items(node)
+        if overlay and name in dictionary.messages and node.get('replace', 'N') != 'Y':
+            msgtype, old = dictionary.messages[name]
+            append_items(old, items)
+            continue
+        msgtype = node.get('msgtype') or (name in dictionary.messages and dictionary.messages[name][0])
+        if not msgtype:
+            fail('%s: message %s needs a msgtype' % (path, name))
+        if name not in dictionary.messages:
+            dictionary.order.append(name)
+        dictionary.messages[name] = (msgtype, items)
+
+
+def load_reused(paths):
+    """Tag number -> (struct name, Tvp base), from the tag structs of existing headers."""
+    reused = {}
+    for path in paths:
+        text = open(path).read()
+        tags = dict(re.findall(r'static constexpr const char\* (Tag\w+) = "(\d+)";', text))
+        for name, base, tag in re.findall(r'^\s*struct (\w+)\s*:\s*public (Tvp\w+)<[^;{]*&(Tag\w+)>', text, re.M):
+            if tag in tags:
+                reused.setdefault(int(tags[tag]), (name, base))
+    return reused
+
+
+def camel(text):
+    words = re.split(r'[^0-9A-Za-z]+', text)
+    name = ''.join(w[:1].upper() + w[1:].lower() for w in words if w)
+    if not name or name[0].isdigit():
+        name = 'V' + name
+    return name
+
+
+def cpp_char(c):
+    return "'\\''" if c == "'" else ("'\\\\'" if c == '\\' else "'%s'" % c)
+
+
+class Generator:
+    def __init__(self, dictionary, namespace, reused, wanted):
+        self.d = dictionary
+        self.ns = namespace
+        self.reused = reused
+        self.messages = [m for m in dictionary.order if not wanted or m in wanted]
+        missing = set(wanted or ()) - set(self.messages)
+        if missing:
+            fail('unknown messages: %s' % ', '.join(sorted(missing)))
+        self.used = {}          # field name -> Field, in first use order
+        self.groups = []        # (entry name, group name, count field, [members])
+        self.group_names = {}   # signature -> group name
+
+    def field(self, name):
+        if name not in self.d.fields:
+            fail('undefined field %s' % name)
+        f = self.d.fields[name]
+        self.used.setdefault(name, f)
+        return f
+
+    def ref(self, f):
+        """Name the generated code uses for a field."""
+        return 'MessageType' if f.number == MSGTYPE_TAG else f.name
+
+    def flatten(self, items, seen, owner, stack=()):
+        """Members with components expanded, groups as ('group', count, entry members)."""
+        out = []
+        for kind, name, sub in items:
+            if kind == 'component':
+                if name not in self.d.components:
+                    fail('undefined component %s' % name)
+                if name in stack:
+                    fail('component %s includes itself' % name)
+                out += self.flatten(self.d.components[name], seen, owner, stack + (name,))
+                continue
+            f = self.field(name)
+            if f.number in FRAME_TAGS or f.number in seen:
+                continue
+            seen.add(f.number)
+            if kind == 'field':
+                out.append(('field', f, None))
+            else:
+                members = self.flatten(sub, set(), owner, stack)
+                if not members:
+                    fail('group %s has no fields' % name)
+                out.append(('group', f, self.group(f, members, owner)))
+        # A field after a group having its tag would be parsed into the group's last entry.
+        inner = set()
+        for kind, f, group in out:
+            if kind == 'group':
+                inner |= self.member_tags(group)
+            elif f.number in inner:
+                fail('%s: field %s follows a group having it' % (owner, f.name))
+        return out
+
+    def member_tags(self, group):
+        """Tags of the entries of `group`, those of nested groups included."""
+        for _, name, _, members in self.groups:
+            if name == group:
+                tags = set()
+                for kind, f, sub in members:
+                    tags.add(f.number)
+                    if kind == 'group':
+                        tags |= self.member_tags(sub)
+                return tags
+        return set()
+
+    def group(self, count, members, owner):
+        signature = (count.name, self.signature(members))
+        if signature in self.group_names:
+            return self.group_names[signature]
+        base = count.name[2:] if count.name.startswith('No') and len(count.name) > 2 else count.name
+        taken = {g[1] for g in self.groups}
+        prefix, suffix, n = base, '', 1
+        while prefix + 'Group' + suffix in taken:
+            prefix, suffix, n = owner + base, (str(n) if n > 1 else ''), n + 1
+        name, entry = prefix + 'Group' + suffix, prefix + 'Entry' + suffix
+        self.groups.append((entry, name, count, members))
+        self.group_names[signature] = name
+        return name
+
+    def signature(self, members):
+        return tuple((k, f.number, g) for k, f, g in members)
+
+    def member_types(self, members):
+        types = []
+        for kind, f, group in members:
+            types.append(self.ref(f))
+            if kind == 'group':
+                types.append(group)
+        return types
+
+    def cases(self, members, target, indent, skip_first=False):
+        lines = []
+        for i, (kind, f, group) in enumerate(members):
+            if skip_first and i == 0:
+                continue
+            if kind == 'field':
+                lines.append('%scase %d: bR += %s<%s>().parse(pd); break;' % (indent, f.number, target, self.ref(f)))
+            else:
+                lines.append('%scase %d:' % (indent, f.number))
+                lines.append('%s    bR += %s<%s>().parse(pd);' % (indent, target, self.ref(f)))
+                lines.append('%s    pd.meta = %s<%s>().get();' % (indent, target, self.ref(f)))
+                lines.append('%s    bR += %s<%s>().parse(pd);' % (indent, target, group))
+                lines.append('%s    break;' % indent)
+        return lines
+
+    def run(self):
+        header = self.d.header
+        # MsgType is a constant of each message, the first field of its body.
+        header_fields = [m for m in self.flatten(header, set(), 'Header') if m[1].number != MSGTYPE_TAG]
+        header_seen = {f.number for _, f, _ in header_fields} | {MSGTYPE_TAG}
+        bodies = []
+        for name in self.messages:
+            msgtype, items = self.d.messages[name]
+            bodies.append((name, msgtype, self.flatten(items, set(header_seen), name)))
+        self.rename_messages(bodies)
+        return self.emit(header_fields, bodies)
+
+    def field_by_number(self, number):
+        for f in self.d.fields.values():
+            if f.number == number:
+                self.used.setdefault(f.name, f)
+                return f
+        fail('the dictionary has no field %d' % number)
+
+    def rename_messages(self, bodies):
+        taken = {self.ref(f) for f in self.used.values()} | {g[0] for g in self.groups} | {g[1] for g in self.groups}
+        taken |= {'Header', 'Message', 'MsgTypeEnum'}
+        self.struct_names = {}
+        for name, _, _ in bodies:
+            self.struct_names[name] = name + 'Message' if name in taken else name
+
+    def field_struct(self, f):
+        tag = '&Tag' + f.name
+        t = f.type
+        if t == 'NUMINGROUP':
+            base = 'TvpInteger<int64_t, %d, %s>' % (f.length or 16, tag)
+            return ('struct %s : public %s {\n'
+                    '        typedef %s Base;\n'
+                    '        int parse(TvpParseData& pd) { int bR = Base::parse(pd); pd.meta = get(); return bR; }\n'
+                    '    };') % (f.name, base, base)
+        if t in CHAR_TYPES:
+            base = 'TvpChar<%s>' % tag
+        elif t == 'SEQNUM':
+            base = 'TvpInteger<int64_t, %d, %s>' % (f.length or 32, tag)
+        elif t in INT_TYPES:
+            base = 'TvpInteger<int, %d, %s>' % (f.length or 16, tag)
+        elif t in FLOAT_TYPES:
+            base = 'TvpFloat<double, %d, %s>' % (f.length or 32, tag)
+        elif t == 'UTCTIMESTAMP':
+            base = 'TvpUtcTimestamp<clock_precision::milliseconds, %s>' % tag
+        elif t in DYNAMIC_TYPES:
+            base = 'TvpStringDynamic<%s>' % tag
+        elif t == 'CURRENCY':
+            base = 'TvpStringFixed<%d, %s>' % (f.length or 16, tag)
+        elif t.startswith('MULTIPLE'):
+            base = 'TvpStringFixed<%d, %s>' % (f.length or 64, tag)
+        else:
+            base = 'TvpStringFixed<%d, %s>' % (f.length or 32, tag)
+        return 'struct %s : public %s {};' % (f.name, base)
+
+    def value_enum(self, f):
+        if not f.values or f.number == MSGTYPE_TAG:
+            return None
+        # A field fixate defines keeps its type, whatever the dictionary says.
+        kind = f.type
+        if f.number in self.reused:
+            kind = {'TvpChar': 'CHAR', 'TvpInteger': 'INT'}.get(self.reused[f.number][1])
+        if kind in CHAR_TYPES:
+            if any(len(v) != 1 for v, _ in f.values):
+                return None
+            underlying, literal = 'char', cpp_char
+        elif kind in INT_TYPES:
+            if any(not re.fullmatch(r'-?\d+', v) for v, _ in f.values):
+                return None
+            underlying, literal = 'int', str
+        else:
+            return None
+        lines = ['enum class %sEnum : %s {' % (f.name, underlying)]
+        names = set()
+        for value, description in f.values:
+            name = camel(description or value)
+            while name in names:
+                name += '_'
+            names.add(name)
+            lines.append('        %s = %s,' % (name, literal(value)))
+        lines.append('    };')
+        return '\n'.join(lines)
+
+    def msgtype_switch(self, bodies):
+        by_len = {}
+        for name, msgtype, _ in bodies:
+            by_len.setdefault(len(msgtype), []).append((msgtype, name))
+        lines = ['switch (str.size()) {']
+        for n in sorted(by_len):
+            lines.append('        case %d:' % n)
+            if n <= 2:
+                key = 'uint8_t(str[0])' if n == 1 else 'uint16_t(uint8_t(str[0]) << 8 | uint8_t(str[1]))'
+                lines.append('            switch (%s) {' % key)
+                for msgtype, name in by_len[n]:
+                    k = ord(msgtype[0]) if n == 1 else (ord(msgtype[0]) << 8 | ord(msgtype[1]))
+                    lines.append('            case 0x%x: return MsgTypeEnum::%s;' % (k, self.struct_names[name]))
+                lines.append('            }')
+            else:
+                for msgtype, name in by_len[n]:
+                    lines.append('            if (str == M_%s) return MsgTypeEnum::%s;' % (self.struct_names[name], self.struct_names[name]))
+            lines.append('            break;')
+        lines.append('        }')
+        return '\n'.join(lines)
+
+    def emit(self, header_fields, bodies):
+        major, minor = self.d.major, self.d.minor
+        if (major, minor) not in {('4', '0'), ('4', '1'), ('4', '2'), ('4', '3'), ('4', '4'), ('5', '0')}:
+            fail('FIX %s.%s is not a FixVersionType' % (major, minor))
+        version = 'FixVersionType::FIX_%s_%s' % (major, minor)
+        out = []
+        w = out.append
+        guard = 'FIXATE_GENERATED_%s_HPP_' % self.ns.upper()
+        w('/**')
+        w('* @file %s.hpp' % self.ns)
+        w('*')
+        w('* Generated by tools/fixgen.py from %s, do not edit.' % ', '.join(self.sources))
+        w('*/')
+        w('#ifndef %s' % guard)
+        w('#define %s' % guard)
+        w('')
+        w('#pragma GCC diagnostic push')
+        w('#pragma GCC diagnostic ignored "-Wsubobject-linkage"')
+        w('')
+        w('#include <string_view>')
+        w('#include "fixate/fixmessage.hpp"')
+        for include in self.includes:
+            w('#include "%s"' % include)
+        w('')
+        w('namespace fixate { namespace %s {' % self.ns)
+        w('')
+        generated = [f for f in self.used.values() if f.number not in self.reused and f.number not in FRAME_TAGS
+                     and f.number != MSGTYPE_TAG]
+        if generated:
+            w('    // Fields fixate doesn\'t define.')
+            for f in generated:
+                w('    static constexpr const char* Tag%s = "%d";' % (f.name, f.number))
+            for f in generated:
+                w('    ' + self.field_struct(f))
+        aliases = [f for f in self.used.values() if f.number in self.reused and f.number != MSGTYPE_TAG
+                   and self.reused[f.number][0] != f.name]
+        if aliases:
+            w('')
+            w('    // Fields fixate defines under another name.')
+            for f in aliases:
+                w('    using %s = ::fixate::%s;' % (f.name, self.reused[f.number][0]))
+        enums = [e for e in (self.value_enum(f) for f in self.used.values()) if e]
+        if enums:
+            w('')
+            for e in enums:
+                w('    ' + e)
+        if self.groups:
+            tags = sorted({f.number for f in self.used.values()} | FRAME_TAGS | {MSGTYPE_TAG})
+            w('')
+            w('    //! Whether a field of the dialect has `tag`.')
+            w('    inline bool dialect_tag(int tag) {')
+            w('        switch (tag) {')
+            for i in range(0, len(tags), 10):
+                w('        ' + ' '.join('case %d:' % t for t in tags[i:i + 10]))
+            w('            return true;')
+            w('        }')
+            w('        return false;')
+            w('    }')
+            w('')
+            w('    // Repeating groups. An entry starts with its delimiter and ends at the next one or at another')
+            w('    // tag of the dialect, tags the dialect doesn\'t have are stepped over.')
+            for entry, group, count, members in self.groups:
+                delimiter = members[0][1]
+                w('    struct %s : public TvpGroup<%s> {' % (entry, ', '.join(self.member_types(members))))
+                w('        int parse(TvpParseData& pd) {')
+                w('            int bR = field<%s>().parse(pd);' % self.ref(delimiter))
+                if members[0][0] == 'group':
+                    fail('group %s starts with a group' % count.name)
+                w('            for (;;) {')
+                w('                int tag = peek_tag(pd.buffer);')
+                w('                switch (tag) {')
+                out.extend(self.cases(members, 'field', '                ', skip_first=True))
+                w('                case %d: case -1: return bR;' % delimiter.number)
+                w('                default:')
+                w('                    if (dialect_tag(tag)) return bR;')
+                w('                    bR += skip_field(pd);')
+                w('                    break;')
+                w('                }')
+                w('            }')
+                w('        }')
+                w('    };')
+                w('    using %s = TvpVector<%s>;' % (group, entry))
+        w('')
+        frame = 'TvpConstant<&TagMessageType, MsgTypeValue>'
+        if header_fields:
+            w('    struct Header : public TvpGroup<')
+            w('        %s' % ', '.join(self.member_types(header_fields)))
+            w('    > {};')
+            w('')
+            frame += ', Header'
+        w('    //! A message of the dialect, its MsgType rendered at compile time.')
+        w('    template <const char* const* MsgTypeValue, typename ... TvpTypes>')
+        w('    struct Message : public FixMessage<%s, %s, TvpTypes...> {' % (version, frame))
+        w('        typedef FixMessage<%s, %s, TvpTypes...> Base;' % (version, frame))
+        w('        using MsgType = TvpConstant<&TagMessageType, MsgTypeValue>;')
+        w('        Message() : Base() {}')
+        w('    };')
+        w('')
+        w('    enum class MsgTypeEnum : uint16_t')
+        w('    {')
+        for i, (name, _, _) in enumerate(bodies):
+            w('        %s%s,' % (self.struct_names[name], ' = 0' if i == 0 else ''))
+        w('    };')
+        w('')
+        for name, msgtype, _ in bodies:
+            w('    static constexpr const char* M_%s = "%s";' % (self.struct_names[name], msgtype))
+        w('')
+        w('    //! MsgType string of a message of the dialect.')
+        w('    inline const char* MsgTypeEnumToString(MsgTypeEnum val) {')
+        w('        switch (val) {')
+        for name, _, _ in bodies:
+            w('        case MsgTypeEnum::%s: return M_%s;' % (self.struct_names[name], self.struct_names[name]))
+        w('        }')
+        w('        return "";')
+        w('    }')
+        w('    //! Message of the dialect for a MsgType value, `MsgTypeEnum(-1)` if it has none.')
+        w('    inline MsgTypeEnum MsgTypeStringToEnum(std::string_view str) {')
+        w('        ' + self.msgtype_switch(bodies))
+        w('        return MsgTypeEnum(-1);')
+        w('    }')
+        for name, _, members in bodies:
+            s = self.struct_names[name]
+            types = self.member_types(members)
+            w('')
+            args = ', '.join(['&M_' + s] + types)
+            w('    struct %s : public Message<' % s)
+            w('        %s' % args)
+            w('    > {')
+            w('        typedef Message<%s> Base;' % args)
+            w('        static constexpr const MsgTypeEnum Type = MsgTypeEnum::%s;' % s)
+            w('        %s() : Base() {}' % s)
+            w('        int parse(const char* src) { return Base::parse<%s>(src); }' % s)
+            w('        static int parse_body(Base::Body& body, TvpParseData& pd) {')
+            w('            int bR = 0;')
+            w('            for (;;) {')
+            w('                switch (peek_tag(pd.buffer)) {')
+            w('                case %d: bR += body.field<Base::MsgType>().parse(pd); break;' % MSGTYPE_TAG)
+            out.extend(self.cases(header_fields + members, 'body.field', '                '))
+            w('                case 10: case -1: return bR;')
+            w('                default: bR += skip_field(pd); break;')
+            w('                }')
+            w('            }')
+            w('        }')
+            w('    };')
+        w('')
+        w('}}')
+        w('')
+        w('#pragma GCC diagnostic pop')
+        w('')
+        w('#endif')
+        return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate fixate message types from a QuickFIX data dictionary.')
+    parser.add_argument('dictionary', help='QuickFIX style XML data dictionary')
+    parser.add_argument('--overlay', action='append', default=[], help='venue dictionary applied on top, in order')
+    parser.add_argument('--namespace', help='namespace in fixate, the dictionary name by default')
+    parser.add_argument('--messages', help='comma separated messages to generate, all by default')
+    parser.add_argument('--reuse', action='append', default=[],
+                        help='header whose tag structs are used rather than redefined, included as given')
+    parser.add_argument('-o', '--output', help='output header, stdout by default')
+    args = parser.parse_args()
+
+    dictionary = Dictionary()
+    load(args.dictionary, dictionary, False)
+    for overlay in args.overlay:
+        load(overlay, dictionary, True)
+    namespace = args.namespace or re.sub(r'\W', '_', os.path.splitext(os.path.basename(args.dictionary))[0].lower())
+    if not re.fullmatch(r'[A-Za-z_]\w*', namespace):
+        fail('%s is not a namespace name' % namespace)
+    wanted = [m.strip() for m in args.messages.split(',')] if args.messages else None
+
+    generator = Generator(dictionary, namespace, load_reused([FIXTAGS] + args.reuse), wanted)
+    generator.sources = [os.path.basename(p) for p in [args.dictionary] + args.overlay]
+    generator.includes = args.reuse
+    text = generator.run()
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()